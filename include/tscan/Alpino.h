@@ -34,6 +34,7 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <array>
 #include <fstream>
 #include <algorithm>
 #include "config.h"
@@ -47,9 +48,31 @@ enum DD_type { SUB_VERB, OBJ1_VERB, OBJ2_VERB, VERB_PP, VERB_VC,
 	       VERB_SVP, VERB_PREDC_N, VERB_PREDC_A, VERB_MOD_BW,
 	       VERB_MOD_A, VERB_NOUN };
 
-std::string MMtoString( const std::multimap<DD_type, int>& mm, DD_type t );
-std::string MMtoString( const std::multimap<DD_type, int>& mm );
-void aggregate( std::multimap<DD_type,int>& out, const std::multimap<DD_type,int>& in );
+const int DD_type_count = VERB_NOUN + 1;
+
+/**
+ * The dependency distances of a word or structure: per DD_type the number
+ * of distances, their sum and the largest one. Merging is a fixed amount
+ * of work, whatever the number of distances.
+ */
+class DistanceStats {
+public:
+  DistanceStats();
+  void add( DD_type, int );
+  void merge( const DistanceStats& );
+  bool empty() const;
+  std::string mean( DD_type ) const;
+  double mean() const;
+  int highest() const;
+private:
+  struct accumulator {
+    int count;
+    int sum;
+    int max;
+  };
+  std::array<accumulator, DD_type_count> acc;
+};
+
 std::string toString( const DD_type& );
 inline std::ostream& operator<< (std::ostream&os, const DD_type& t ){
   os << toString( t );
@@ -73,8 +96,8 @@ void mod_stats( xmlDoc *, int&, int& );
 int get_d_level( const folia::Sentence *s, xmlDoc *alp );
 int indef_npcount( xmlDoc *alp );
 WWform classifyVerb( const xmlNode *, const std::string&, std::string& );
-std::multimap<DD_type, int> getDependencyDist( const xmlNode *,
-                                               const std::set<size_t> & );
+DistanceStats getDependencyDist( const xmlNode *,
+                                 const std::set<size_t> & );
 // bool isSmallCnj( const xmlNode *);
 
 std::list<xmlNode*> getAdverbialNodes( xmlDoc* );
@@ -0,0 +1,50 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <new>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <stddef.h>
+
+/**
+ * A monotonic arena for the nodes of a stats tree (document, paragraphs,
+ * sentences and words). Objects are placed one after the other in large
+ * blocks and are never freed separately: the arena destroys them all,
+ * newest first, and releases its blocks when it is destroyed itself.
+ * An arena is used by one thread at a time.
+ */
+class StatsArena {
+public:
+  explicit StatsArena( size_t block_size = 64 * 1024 );
+  ~StatsArena();
+  /// @brief construct a T in the arena, owned by the arena
+  template <class T, typename... Args>
+  T *make( Args&&... args ) {
+    void *p = allocate( sizeof( T ), alignof( T ) );
+    T *obj = new ( p ) T( std::forward<Args>( args )... );
+    if ( !std::is_trivially_destructible<T>::value ) {
+      cleanups.push_back( cleanup( obj, &destroy<T> ) );
+    }
+    return obj;
+  }
+  /// @brief the number of bytes taken by the blocks
+  size_t capacity() const { return reserved; };
+private:
+  StatsArena( const StatsArena& ) = delete;
+  StatsArena& operator=( const StatsArena& ) = delete;
+  void *allocate( size_t size, size_t align );
+  template <class T>
+  static void destroy( void *obj ) {
+    static_cast<T *>( obj )->~T();
+  }
+  typedef std::pair<void *, void ( * )( void * )> cleanup;
+  size_t block_size;
+  size_t reserved;
+  std::vector<char *> blocks;
+  char *current;
+  size_t left;
+  std::vector<cleanup> cleanups;
+};
+
+#endif /* ARENA_H */
@@ -0,0 +1,73 @@
+#ifndef ASYNC_H
+#define ASYNC_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <future>
+
+/**
+ * Non-blocking client for the backend servers (Alpino, Wopr, Frog and the
+ * compound splitter).
+ * One event loop thread multiplexes all outstanding requests over
+ * non-blocking sockets, so many parses can be in flight without a thread
+ * per request. Every request gets a fresh connection, just like the
+ * blocking Sockets::ClientSocket calls did.
+ * Host names are resolved by the thread that makes the request, once per
+ * host and port, so a slow name server never stops the event loop.
+ * A request that is not answered within the timeout fails, so a stalled
+ * server can't hang its callers.
+ */
+class AsyncClient {
+public:
+  /**
+   * How the end of a reply is recognized
+   */
+  enum Until {
+    END_OF_STREAM, // the server closes the connection
+    FIRST_LINE,    // the first line is the reply
+    MARKER_LINE    // read up to (not including) a line holding the marker
+  };
+  explicit AsyncClient( size_t max_in_flight = 64, int timeout = 0 );
+  ~AsyncClient();
+  std::shared_future<std::string> request( const std::string& host,
+                                           const std::string& port,
+                                           const std::string& message,
+                                           Until until = END_OF_STREAM,
+                                           const std::string& marker = "" );
+  void setMaxInFlight( size_t );
+  /// @brief the seconds a request may take, from its connect on; 0 for
+  /// no limit
+  void setTimeout( int );
+private:
+  struct Address;
+  struct Request;
+  void run();
+  bool open( Request * );
+  bool progress( Request *, short );
+  void wake();
+  bool resolve( const std::string& host, const std::string& port,
+                std::vector<Address>&, std::string& message );
+  std::mutex resolve_mtx;
+  std::map<std::string, std::vector<Address>> addresses;
+  std::mutex mtx;
+  std::deque<Request *> queued;
+  std::vector<Request *> active;
+  size_t max_in_flight;
+  int timeout;
+  bool stopping;
+  int wake_pipe[2];
+  std::thread loop;
+};
+
+/**
+ * Wait for a reply. Returns false and fills 'message' when the request
+ * failed (no connection, connection lost, timed out).
+ */
+bool getReply( const std::shared_future<std::string>&, std::string& reply,
+               std::string& message );
+
+#endif /* ASYNC_H */
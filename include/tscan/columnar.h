@@ -0,0 +1,81 @@
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include <unordered_map>
+#include <stdint.h>
+#include "tscan/csv.h"
+
+class spoolFile;
+
+/**
+ * The rows of one .csv table in typed columns, filled through a csvRow by
+ * the same toCSV() functions that write the .csv text. The schema is
+ * fixed: the columns are those of the header, and a column holds strings
+ * when it is one of the given string columns, and doubles otherwise, with
+ * NaN for NA.
+ */
+class ColumnarTable : public csvFields {
+public:
+  explicit ColumnarTable( const std::vector<std::string>& string_columns );
+  void header( const std::vector<std::string>& ) override;
+  void row( const std::vector<csvField>& ) override;
+  size_t rows() const { return row_count; };
+private:
+  friend class ColumnarWriter;
+  ColumnarTable( const ColumnarTable& ) = delete;
+  ColumnarTable& operator=( const ColumnarTable& ) = delete;
+  struct column {
+    std::string name;
+    bool is_string;
+    std::vector<double> numbers;
+    std::vector<uint32_t> indexes;
+    std::unordered_map<std::string, uint32_t> dictionary;
+    std::vector<const std::string *> entries;
+  };
+  const std::vector<std::string>& string_columns;
+  std::vector<column> columns;
+  size_t row_count;
+};
+
+/**
+ * A columnar binary version of the .csv output, for loading into analysis
+ * tools without parsing text.
+ *
+ * The file starts with the 8 bytes "TSCOL02\n" and the schema, followed
+ * by row groups, e.g. one per document or paragraph, up to the end of the
+ * file. All numbers are little endian. The row groups of a document that
+ * is written part by part can be spooled, and added together when it is
+ * complete.
+ *   schema:    u32 column count, then per column:
+ *                u32 name length, name, u8 type
+ *   row group: u64 row count, then the values of each column:
+ *   type 1 (DOUBLE):  row count f64 values, NaN for NA
+ *   type 2 (STRING):  u32 dictionary size, per entry u32 length and bytes,
+ *                     then row count u32 indexes into the dictionary,
+ *                     0xFFFFFFFF for NA
+ */
+class ColumnarWriter {
+public:
+  explicit ColumnarWriter( const std::string& filename );
+  ~ColumnarWriter();
+  bool good() const { return static_cast<bool>( file ); };
+  void add( const ColumnarTable& );
+  void spool( const ColumnarTable&, spoolFile& );
+  void add( spoolFile& );
+private:
+  ColumnarWriter( const ColumnarWriter& ) = delete;
+  ColumnarWriter& operator=( const ColumnarWriter& ) = delete;
+  bool schema( const ColumnarTable& );
+  static void group( std::ostream&, const ColumnarTable& );
+  std::string filename;
+  std::ofstream file;
+  std::vector<std::string> names;
+  bool has_schema;
+  std::mutex mtx;
+};
+
+#endif /* COLUMNAR_H */
@@ -0,0 +1,54 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include <stddef.h>
+
+class spoolFile;
+
+/**
+ * Collects the .csv tables of all documents of a run in one file per
+ * table, e.g. 'prefix.words.csv', instead of a set of files per document.
+ * A document is added as the text its own .csv files would have, header
+ * line included; the header is written once per file. The tables of a
+ * document are appended together under a lock, so documents written by
+ * several output workers never interleave.
+ * A document that is written one part at a time, e.g. a paragraph, is
+ * collected in a spoolFile per table first, and added from there once it
+ * is complete, so a document that fails halfway adds nothing.
+ * With a shard size, a table moves on to a next numbered file
+ * ('prefix.words.0002.csv') when it would grow beyond that size. The
+ * rows of one document always stay in one file.
+ */
+class CorpusWriter {
+public:
+  CorpusWriter( const std::string& prefix,
+                const std::vector<std::string>& tables,
+                size_t shard_size = 0 );
+  ~CorpusWriter();
+  void add( const std::vector<std::string>& texts );
+  void add( const std::vector<spoolFile*>& spools );
+private:
+  CorpusWriter( const CorpusWriter& ) = delete;
+  CorpusWriter& operator=( const CorpusWriter& ) = delete;
+  struct table {
+    std::string name;
+    std::string header;
+    std::ofstream file;
+    size_t shard;
+    size_t written;
+  };
+  void open( table& );
+  void prepare( table&, const std::string&, size_t );
+  void append( table&, const std::string& );
+  void append( table&, spoolFile& );
+  std::string prefix;
+  size_t shard_size;
+  std::vector<table> tables;
+  std::mutex mtx;
+};
+
+#endif /* CORPUS_H */
@@ -0,0 +1,162 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stddef.h>
+
+struct proportion;
+struct density;
+
+/**
+ * Make a stream format its doubles for .csv output with snprintf instead
+ * of the locale machinery of the standard facet. The text is the same, as
+ * this is only done when the locale of the stream uses a '.' and no digit
+ * grouping, and values with a field width or unusual flags are still left
+ * to the standard facet.
+ */
+void csvStream( std::ios& );
+
+/**
+ * A .csv output file with a large buffer and the csvStream() formatting,
+ * so rows are written in large blocks
+ */
+class csvFile : public std::ofstream {
+public:
+  csvFile();
+  explicit csvFile( const std::string& );
+  ~csvFile();
+private:
+  std::vector<char> buffer;
+};
+
+/**
+ * A .csv field between quotes, with any quotes in it doubled
+ */
+struct csvQuoted {
+  explicit csvQuoted( const std::string& s ): text( s ) {};
+  const std::string& text;
+};
+
+std::ostream& operator<<( std::ostream&, const csvQuoted& );
+
+/**
+ * A .csv number that is "NA" when it is NaN, with 6 significant digits
+ */
+struct csvNumber {
+  explicit csvNumber( double d ): value( d ) {};
+  double value;
+};
+
+std::ostream& operator<<( std::ostream&, const csvNumber& );
+
+/**
+ * One field of a row of .csv output as a typed value. Text that only comes
+ * from the format itself, like the "0" of a word without a category, is
+ * literal; text that comes from the data, like a word, is not.
+ */
+struct csvField {
+  enum Kind { NA, NUMBER, TEXT };
+  csvField(): kind( NA ), number( 0 ), literal( true ) {};
+  Kind kind;
+  double number;
+  std::string text;
+  bool literal;
+};
+
+/**
+ * Receives the rows of a .csv table as typed fields
+ */
+class csvFields {
+public:
+  virtual ~csvFields() {};
+  virtual void header( const std::vector<std::string>& names ) = 0;
+  virtual void row( const std::vector<csvField>& fields ) = 0;
+};
+
+/**
+ * Where the toCSV() functions of the stats write to, as to a stream.
+ * A text row passes everything on to a stream. A typed row hands the
+ * values to a csvFields instead: a ',' in the text of the format ends a
+ * field and a '\n' a row, and the values themselves are never turned
+ * into text and back, so numbers keep their precision and a word like
+ * "NA" stays a word.
+ */
+class csvRow {
+public:
+  explicit csvRow( std::ostream& s ): os( &s ), fields( 0 ),
+    in_header( false ), started( false ) {};
+  explicit csvRow( csvFields& f ): os( 0 ), fields( &f ),
+    in_header( false ), started( false ) {};
+  /// the next row is the header, with the column names
+  void startHeader() { in_header = true; };
+  csvRow& operator<<( const char *s ) {
+    if ( os ) *os << s; else format( s );
+    return *this;
+  };
+  csvRow& operator<<( char c ) {
+    if ( os ) *os << c; else format( c );
+    return *this;
+  };
+  csvRow& operator<<( const std::string& s ) {
+    if ( os ) *os << s; else data( s );
+    return *this;
+  };
+  csvRow& operator<<( const csvQuoted& q ) {
+    if ( os ) *os << q; else data( q.text );
+    return *this;
+  };
+  csvRow& operator<<( const csvNumber& n );
+  csvRow& operator<<( const proportion& p );
+  csvRow& operator<<( const density& d );
+  csvRow& operator<<( bool b ) { return put( b ); };
+  csvRow& operator<<( int i ) { return put( i ); };
+  csvRow& operator<<( unsigned int i ) { return put( i ); };
+  csvRow& operator<<( long i ) { return put( i ); };
+  csvRow& operator<<( unsigned long i ) { return put( i ); };
+  csvRow& operator<<( long long i ) { return put( i ); };
+  csvRow& operator<<( unsigned long long i ) { return put( i ); };
+  csvRow& operator<<( float d ) { return put( d ); };
+  csvRow& operator<<( double d ) { return put( d ); };
+  csvRow& operator<<( std::ios_base& (*manip)( std::ios_base& ) ) {
+    if ( os ) *os << manip;
+    return *this;
+  };
+  /// anything else, like the labels of the enums, is text
+  template <class T> csvRow& operator<<( const T& v ) {
+    if ( os ) {
+      *os << v;
+    }
+    else {
+      std::ostringstream text;
+      text << v;
+      data( text.str() );
+    }
+    return *this;
+  };
+private:
+  csvRow( const csvRow& ) = delete;
+  csvRow& operator=( const csvRow& ) = delete;
+  template <class T> csvRow& put( T v ) {
+    if ( os ) *os << v; else number( v );
+    return *this;
+  };
+  void format( const char * );
+  void format( char );
+  void data( const std::string& );
+  void number( double );
+  void endField();
+  void endRow();
+  std::ostream *os;
+  csvFields *fields;
+  bool in_header;
+  bool started;
+  csvField field;
+  std::vector<csvField> values;
+  std::vector<std::string> names;
+};
+
+#endif /* CSV_H */
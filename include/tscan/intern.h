@@ -0,0 +1,149 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <string>
+#include <ostream>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <unordered_map>
+#include <stdint.h>
+
+/**
+ * Maps strings (words, lemmas) to small integer ids, and back.
+ * Id 0 is the empty string.
+ * The ids stay valid as long as a Lease is held, so statistics kept by
+ * id can be reused between documents (see the sentence cache).
+ * When more than 'limit' strings are stored, the interner starts a new
+ * generation: the next Lease waits until all others are released, and
+ * then forgets all strings. Anything that keeps ids between documents
+ * must check generation().
+ * Looking up the string of an id takes no lock: the strings are kept in
+ * fixed chunks that are only appended to.
+ */
+class StringInterner {
+public:
+  StringInterner();
+  ~StringInterner();
+  uint32_t id( const std::string& );
+  const std::string& str( uint32_t id ) const {
+    return *chunks[id >> chunk_bits].load( std::memory_order_acquire )[id & chunk_mask];
+  };
+  size_t size() const { return count.load( std::memory_order_acquire ); };
+  size_t bytes() const;
+  uint32_t generation() const { return gen.load( std::memory_order_acquire ); };
+  /// @brief the number of strings that starts a new generation, 0 for none
+  void setLimit( size_t l ) { limit = l; };
+  /**
+   * Keeps the ids valid while it exists. Take one before a document is
+   * analysed, and release it when its output is written.
+   */
+  class Lease {
+  public:
+    explicit Lease( StringInterner& );
+    ~Lease();
+  private:
+    Lease( const Lease& );
+    Lease& operator=( const Lease& );
+    StringInterner& owner;
+  };
+private:
+  StringInterner( const StringInterner& );
+  StringInterner& operator=( const StringInterner& );
+  static const size_t chunk_bits = 16;
+  static const size_t chunk_mask = ( size_t( 1 ) << chunk_bits ) - 1;
+  static const size_t max_chunks = size_t( 1 ) << ( 32 - chunk_bits );
+  uint32_t add( const std::string& );
+  void clear();
+  std::unordered_map<std::string, uint32_t> ids;
+  size_t chars;
+  size_t limit;
+  size_t leases;
+  std::atomic<size_t> count;
+  std::atomic<uint32_t> gen;
+  std::atomic<const std::string **> chunks[max_chunks];
+  mutable std::mutex mtx;
+  std::condition_variable released;
+};
+
+/// @brief the interner for all words and lemmas
+extern StringInterner word_ids;
+
+/**
+ * A string kept in word_ids, stored as its 32-bit id. It converts to a
+ * const std::string& wherever a string is expected, so a record can hold
+ * one instead of a std::string of its own.
+ */
+class interned_string {
+public:
+  interned_string(): id_( 0 ) {};
+  interned_string( const std::string& s ): id_( word_ids.id( s ) ) {};
+  interned_string& operator=( const std::string& s ) {
+    id_ = word_ids.id( s );
+    return *this;
+  };
+  uint32_t id() const { return id_; };
+  const std::string& str() const { return word_ids.str( id_ ); };
+  operator const std::string&() const { return str(); };
+  bool empty() const { return id_ == 0; };
+  size_t size() const { return str().size(); };
+  size_t length() const { return str().length(); };
+  char operator[]( size_t i ) const { return str()[i]; };
+private:
+  uint32_t id_;
+};
+
+inline bool operator==( const interned_string& a, const interned_string& b ) {
+  return a.id() == b.id();
+}
+inline bool operator!=( const interned_string& a, const interned_string& b ) {
+  return a.id() != b.id();
+}
+inline bool operator==( const interned_string& a, const std::string& b ) {
+  return a.str() == b;
+}
+inline bool operator!=( const interned_string& a, const std::string& b ) {
+  return a.str() != b;
+}
+inline bool operator==( const interned_string& a, const char *b ) {
+  return a.str() == b;
+}
+inline bool operator!=( const interned_string& a, const char *b ) {
+  return a.str() != b;
+}
+inline std::string operator+( const std::string& a, const interned_string& b ) {
+  return a + b.str();
+}
+inline std::string operator+( const interned_string& a, const std::string& b ) {
+  return a.str() + b;
+}
+inline std::ostream& operator<<( std::ostream& os, const interned_string& s ) {
+  return os << s.str();
+}
+
+/**
+ * Counts occurrences per id, in an open addressing hash table.
+ * Used for the type/token counters of the structures, which are merged
+ * from sentence to paragraph to document.
+ */
+class IdCounter {
+public:
+  IdCounter(): used( 0 ) {};
+  void add( uint32_t id, int count = 1 );
+  void merge( const IdCounter& );
+  int count( uint32_t ) const;
+  /// @brief the number of different ids
+  size_t size() const { return used; };
+  bool empty() const { return used == 0; };
+  size_t countAtMost( int ) const;
+private:
+  static const uint32_t empty_slot = uint32_t( -1 );
+  size_t slot( uint32_t ) const;
+  void grow();
+  std::vector<uint32_t> keys;
+  std::vector<int> counts;
+  size_t used;
+};
+
+#endif /* INTERN_H */
@@ -0,0 +1,40 @@
+#ifndef MEMO_H
+#define MEMO_H
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <iostream>
+#include <sys/types.h>
+
+/**
+ * A persistent key/value cache for the results of backend requests,
+ * with an in-memory map in front of an append-only file.
+ * The file name holds the name and version of the backend, so changing
+ * either starts a new cache.
+ * Several tscan processes can share the same file: writes append whole
+ * lines under an exclusive lock, and a miss first reads the entries that
+ * other processes appended since the last look.
+ */
+class MemoCache {
+public:
+  MemoCache( const std::string& name );
+  ~MemoCache();
+  void open( const std::string& dir, const std::string& version );
+  bool lookup( const std::string& key, std::string& value );
+  bool contains( const std::string& key );
+  void store( const std::string& key, const std::string& value );
+  void report( std::ostream& ) const;
+private:
+  void readNew();
+  std::string name;
+  std::string filename;
+  int fd;
+  off_t offset;
+  std::map<std::string, std::string> entries;
+  size_t hits;
+  size_t misses;
+  mutable std::mutex mtx;
+};
+
+#endif /* MEMO_H */
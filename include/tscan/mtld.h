@@ -0,0 +1,23 @@
+#ifndef MTLD_H
+#define MTLD_H
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * MTLD (Measure of Textual Lexical Diversity) over series of token ids,
+ * see McCarthy & Jarvis (2010).
+ * Each series is scored forwards and backwards in the same pass, and the
+ * two scores are averaged. The types of the current factor are kept in
+ * a table indexed by id and stamped with a generation number, so starting
+ * a new factor costs nothing.
+ * When the series are long enough together, they are divided over
+ * several threads.
+ */
+typedef std::vector<uint32_t> mtld_series;
+
+double average_mtld( const mtld_series&, double threshold );
+std::vector<double> average_mtlds( const std::vector<mtld_series>&,
+                                   double threshold );
+
+#endif /* MTLD_H */
@@ -2,6 +2,7 @@
 #define NER_H
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include "libfolia/folia.h"
 #include "tscan/sem.h"
@@ -17,7 +18,9 @@ namespace NER {
         PER_B, PER_I,
         PRO_B, PRO_I
     };
-    Type lookupNer(const folia::Word*, const folia::Sentence*);
+    /// the NER type of each word of a sentence, by position
+    typedef std::vector<Type> Index;
+    Index indexNers(const std::vector<folia::Word*>&, const folia::Sentence*);
     std::string toString(Type);
     std::ostream& operator<<(std::ostream&, Type);
 
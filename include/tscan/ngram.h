@@ -0,0 +1,54 @@
+#ifndef NGRAM_H
+#define NGRAM_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdint.h>
+
+/**
+ * An n-gram language model, scored in-process as an alternative to the
+ * Wopr servers.
+ * The model is a binary file made from an ARPA file by tscan-lmconvert.
+ * It is memory-mapped, so it loads instantly and is shared between
+ * processes. The file holds a sorted vocabulary and, per order, a sorted
+ * table of fixed-size records (word ids, log10 prob, log10 backoff),
+ * searched by bisection.
+ * A backward model is an ordinary model trained on reversed sentences;
+ * it is marked as such, and scores the words from right to left.
+ * Words that are not in the vocabulary score as <unk>; a model without
+ * <unk> gives them its lowest unigram probability, so they never make
+ * the sentence scores NaN.
+ */
+class NgramModel {
+public:
+  NgramModel();
+  ~NgramModel();
+  bool load( const std::string& filename, bool backward, std::string& message );
+  bool loaded() const { return base != 0; };
+  void score( const std::vector<std::string>& words,
+              std::vector<double>& lprob10,
+              double& avg_prob10,
+              double& entropy,
+              double& perplexity ) const;
+  static bool convertArpa( std::istream& arpa, const std::string& outfile,
+                           std::string& message );
+private:
+  uint32_t wordId( const std::string& ) const;
+  const float *find( const uint32_t *ids, size_t n ) const;
+  double logprob( const uint32_t *ngram, size_t n ) const;
+  const char *base;
+  size_t size;
+  bool backward;
+  uint32_t order;
+  uint64_t vocab_size;
+  const uint64_t *vocab_offsets;
+  const char *vocab_chars;
+  std::vector<const char *> tables;
+  std::vector<uint64_t> counts;
+  uint32_t unk;
+  uint32_t start;
+  float oov_prob10;
+};
+
+#endif /* NGRAM_H */
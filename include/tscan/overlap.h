@@ -0,0 +1,39 @@
+#ifndef OVERLAP_H
+#define OVERLAP_H
+
+#include <vector>
+#include <memory>
+#include <stdint.h>
+#include "tscan/intern.h"
+
+/**
+ * The words (or lemmas) that a word can have argument overlap with: the
+ * previous sentence, or the last 'overlapSize' words of the document.
+ * A word overlaps when it occurs in the window, or when it is a personal
+ * pronoun of the same person and number as a pronoun in the window.
+ * The window counts its ids and its pronoun classes, so checking a word
+ * and moving the window one word along take constant time, whatever the
+ * size of the window.
+ */
+class OverlapWindow {
+public:
+  /// @brief a window of 'capacity' ids, or an unlimited one when 0
+  explicit OverlapWindow( size_t capacity = 0 );
+  void push( uint32_t id );
+  bool overlaps( uint32_t id ) const;
+  bool full() const { return capacity > 0 && filled == capacity; };
+  bool empty() const { return filled == 0; };
+private:
+  static const int pronoun_class_count = 7;
+  size_t capacity;
+  size_t filled;
+  size_t oldest;
+  std::vector<uint32_t> ring;
+  IdCounter id_counts;
+  int class_counts[pronoun_class_count];
+  std::shared_ptr<const std::vector<unsigned char>> pronouns;
+  void count( uint32_t id, int delta );
+  unsigned char pronoun_class( uint32_t id ) const;
+};
+
+#endif /* OVERLAP_H */
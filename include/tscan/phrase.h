@@ -0,0 +1,64 @@
+#ifndef PHRASE_H
+#define PHRASE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+namespace Phrase {
+  /// @brief the multi-word lexicons held by a PhraseTrie
+  enum Lexicon {
+    INTENSIFY, FORMAL, PREP_EXPR, CONNECTIVE, NEGATIVE, SITUATION,
+    LEXICON_COUNT
+  };
+}
+
+/**
+ * The phrases found in one sentence, ordered on start position and length
+ */
+class PhraseMatches {
+public:
+  int find( size_t start, size_t length, Phrase::Lexicon ) const;
+  int shortest( size_t start, size_t max_length, Phrase::Lexicon,
+                size_t& length ) const;
+private:
+  friend class PhraseTrie;
+  struct Match {
+    size_t length;
+    const int *values;
+  };
+  std::vector<Match> matches;
+  /// @brief per start position, the index of its first match
+  std::vector<size_t> first;
+};
+
+/**
+ * A token trie over all multi-word lexicons that are matched against the
+ * same kind of token (lowercased words, or lemmas).
+ * The tokens are interned once, when the trie is built; a sentence is
+ * then matched by walking the trie from every position, which stops at
+ * the first token that can not extend a phrase. A phrase can be in
+ * several lexicons, each with its own value. When it is added twice to
+ * the same lexicon, the first value is kept, so the order of adding sets
+ * the priority between lists.
+ */
+class PhraseTrie {
+public:
+  PhraseTrie();
+  void add( const std::string& phrase, Phrase::Lexicon, int value );
+  void match( const std::vector<std::string>& tokens, PhraseMatches& ) const;
+private:
+  struct Node {
+    Node();
+    /// @brief (token id, node index) pairs, sorted on token id
+    std::vector<std::pair<uint32_t, uint32_t>> children;
+    int values[Phrase::LEXICON_COUNT];
+    bool terminal;
+  };
+  uint32_t child( uint32_t node, uint32_t token ) const;
+  std::unordered_map<std::string, uint32_t> vocabulary;
+  std::vector<Node> nodes;
+};
+
+#endif /* PHRASE_H */
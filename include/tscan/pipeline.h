@@ -0,0 +1,116 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * A FIFO queue with a fixed capacity, connecting two pipeline stages.
+ * push() blocks while the queue is full, pop() blocks while it is empty.
+ * The queue closes itself when the last registered producer is done;
+ * after that pop() drains the remaining items and then returns false.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue( size_t cap ):
+    capacity( cap > 0 ? cap : 1 ),
+    producers( 0 ),
+    closed( false ) {};
+  void addProducers( size_t n ) {
+    std::lock_guard<std::mutex> lock( mtx );
+    producers += n;
+  };
+  void producerDone() {
+    std::lock_guard<std::mutex> lock( mtx );
+    if ( producers > 0 && --producers == 0 ) {
+      closed = true;
+      not_empty.notify_all();
+      not_full.notify_all();
+    }
+  };
+  bool push( const T& item ) {
+    std::unique_lock<std::mutex> lock( mtx );
+    while ( !closed && items.size() >= capacity ) {
+      not_full.wait( lock );
+    }
+    if ( closed ) {
+      return false;
+    }
+    items.push_back( item );
+    not_empty.notify_one();
+    return true;
+  };
+  bool pop( T& item ) {
+    std::unique_lock<std::mutex> lock( mtx );
+    while ( !closed && items.empty() ) {
+      not_empty.wait( lock );
+    }
+    if ( items.empty() ) {
+      return false;
+    }
+    item = items.front();
+    items.pop_front();
+    not_full.notify_one();
+    return true;
+  };
+private:
+  size_t capacity;
+  size_t producers;
+  bool closed;
+  std::deque<T> items;
+  std::mutex mtx;
+  std::condition_variable not_empty;
+  std::condition_variable not_full;
+};
+
+/**
+ * Start a pipeline stage of 'workers' threads. Each thread takes items
+ * from 'in', applies 'fun' and pushes the result on 'out' when 'fun'
+ * returns true. Items for which 'fun' returns false are dropped, so 'fun'
+ * is responsible for cleaning them up.
+ */
+template <typename In, typename Out, typename Fun>
+void startStage( std::vector<std::thread>& threads, size_t workers,
+                 BoundedQueue<In>& in, BoundedQueue<Out>& out, Fun fun ) {
+  if ( workers == 0 ) {
+    workers = 1;
+  }
+  out.addProducers( workers );
+  for ( size_t i = 0; i < workers; ++i ) {
+    threads.push_back( std::thread( [&in, &out, fun]() {
+      In item;
+      while ( in.pop( item ) ) {
+        Out result;
+        if ( fun( item, result ) ) {
+          out.push( result );
+        }
+      }
+      out.producerDone();
+    } ) );
+  }
+}
+
+/**
+ * Start the final pipeline stage: 'workers' threads consuming 'in'.
+ */
+template <typename In, typename Fun>
+void startSink( std::vector<std::thread>& threads, size_t workers,
+                BoundedQueue<In>& in, Fun fun ) {
+  if ( workers == 0 ) {
+    workers = 1;
+  }
+  for ( size_t i = 0; i < workers; ++i ) {
+    threads.push_back( std::thread( [&in, fun]() {
+      In item;
+      while ( in.pop( item ) ) {
+        fun( item );
+      }
+    } ) );
+  }
+}
+
+#endif /* PIPELINE_H */
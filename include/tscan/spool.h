@@ -0,0 +1,32 @@
+#ifndef SPOOL_H
+#define SPOOL_H
+
+#include <string>
+#include <ostream>
+#include <cstdio>
+
+/**
+ * A temporary file that collects the output of one document part by part,
+ * so a corpus writer can add it as a whole once the document is done.
+ * The file is removed when the spool is destroyed, also when it was never
+ * added because the document failed halfway.
+ */
+class spoolFile {
+public:
+  spoolFile();
+  ~spoolFile();
+  bool good() const { return file != 0 && !failed; };
+  size_t size() const { return bytes; };
+  void write( const std::string& );
+  bool getline( std::string& );
+  bool copy( std::ostream& );
+  void rewind();
+private:
+  spoolFile( const spoolFile& ) = delete;
+  spoolFile& operator=( const spoolFile& ) = delete;
+  std::FILE *file;
+  size_t bytes;
+  bool failed;
+};
+
+#endif /* SPOOL_H */
@@ -3,8 +3,11 @@
 
 #include <cmath>
 #include <map>
+#include <array>
+#include <memory>
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include "ticcutils/XMLtools.h"
 #include "libfolia/folia.h"
@@ -20,13 +23,69 @@
 #include "tscan/adverb.h"
 #include "tscan/ner.h"
 #include "tscan/utils.h"
+#include "tscan/phrase.h"
+#include "tscan/intern.h"
+#include "tscan/mtld.h"
+#include "tscan/csv.h"
 
 struct sentStats; // Forward declaration
 struct wordStats; // Forward declaration
+struct lemma_class; // Forward declaration
+class OverlapWindow; // Forward declaration
+class StatsArena; // Forward declaration
+
+/// @brief all words of a document, in text order
+typedef std::vector<const wordStats *> word_index;
+
+/**
+ * The words of one structure: a range in the word_index of its document
+ */
+class word_range {
+public:
+  word_range(): first( 0 ), last( 0 ) {};
+  word_range( const wordStats *const *f, const wordStats *const *l ):
+    first( f ), last( l ) {};
+  const wordStats *const *begin() const { return first; };
+  const wordStats *const *end() const { return last; };
+  size_t size() const { return last - first; };
+  bool empty() const { return first == last; };
+private:
+  const wordStats *const *first;
+  const wordStats *const *last;
+};
 
 enum top_val { top1000, top2000, top3000, top5000, top10000, top20000, notFound };
 enum csvKind { DOC_CSV, PAR_CSV, SENT_CSV, WORD_CSV };
 
+/// @brief the features of the Frog POS tag that the analysis uses
+enum posFeature { WVORM, POSITIE, PVTIJD, VWTYPE, NAAMVAL, PERSOON,
+                  CONJTYPE, POS_FEATURE_COUNT };
+typedef std::array<std::string, POS_FEATURE_COUNT> posFeatures;
+
+/**
+ * The Frog annotation of the words of a sentence, read from the FoLiA tree
+ * in one pass and stored per kind, by word position, so the analysis does
+ * not have to select it from the words again
+ */
+struct sentenceAnnotations {
+  sentenceAnnotations( const folia::Sentence*,
+                       const std::vector<folia::Word*>& );
+  size_t size() const { return text.size(); };
+  void checkPos( size_t ) const;
+  std::vector<icu::UnicodeString> text;
+  std::vector<bool> has_pos;
+  std::vector<std::string> pos;
+  std::vector<CGN::Type> tag;
+  std::vector<posFeatures> features;
+  std::vector<std::string> lemma;
+  std::vector<std::vector<std::string>> morphs;
+  std::vector<std::vector<std::string>> compounds;
+  // the NP chunks: their sizes and the position of their first word
+  // (-1 when that is not a word of the sentence)
+  std::vector<size_t> np_sizes;
+  std::vector<int> np_firsts;
+};
+
 struct basicStats {
   basicStats( int pos, folia::FoliaElement* el, const std::string& cat ):
     folia_node( el ),
@@ -44,42 +103,44 @@ struct basicStats {
     }
   };
   virtual ~basicStats(){};
-  virtual void CSVheader( std::ostream&, const std::string& = "" ) const = 0;
-  virtual void wordDifficultiesHeader( std::ostream& ) const = 0;
-  virtual void wordDifficultiesToCSV( std::ostream& ) const = 0;
-  virtual void compoundHeader( std::ostream& ) const = 0;
-  virtual void compoundToCSV( std::ostream& ) const = 0;
-  virtual void sentDifficultiesHeader( std::ostream& ) const = 0;
-  virtual void sentDifficultiesToCSV( std::ostream& ) const = 0;
-  virtual void infoHeader( std::ostream& ) const = 0;
-  virtual void informationDensityToCSV( std::ostream& ) const = 0;
-  virtual void coherenceHeader( std::ostream& ) const = 0;
-  virtual void coherenceToCSV( std::ostream& ) const = 0;
-  virtual void concreetHeader( std::ostream& ) const = 0;
-  virtual void concreetToCSV( std::ostream& ) const = 0;
-  virtual void persoonlijkheidHeader( std::ostream& ) const = 0;
-  virtual void persoonlijkheidToCSV( std::ostream& ) const = 0;
-  virtual void verbHeader( std::ostream& ) const = 0;
-  virtual void verbToCSV( std::ostream& ) const = 0;
-  virtual void imperativeHeader( std::ostream& ) const = 0;
-  virtual void imperativeToCSV( std::ostream& ) const = 0;
-  virtual void wordSortHeader( std::ostream& ) const = 0;
-  virtual void wordSortToCSV( std::ostream& ) const = 0;
-  virtual void prepPhraseHeader( std::ostream& ) const = 0;
-  virtual void prepPhraseToCSV( std::ostream& ) const = 0;
-  virtual void intensHeader( std::ostream& ) const = 0;
-  virtual void intensToCSV( std::ostream& ) const = 0;
-  virtual void formalHeader( std::ostream& ) const = 0;
-  virtual void formalToCSV( std::ostream& ) const = 0;
-  virtual void miscToCSV( std::ostream& ) const = 0;
-  virtual void miscHeader( std::ostream& ) const = 0;
+  virtual void CSVheader( csvRow&, const std::string& = "" ) const = 0;
+  virtual void wordDifficultiesHeader( csvRow& ) const = 0;
+  virtual void wordDifficultiesToCSV( csvRow& ) const = 0;
+  virtual void compoundHeader( csvRow& ) const = 0;
+  virtual void compoundToCSV( csvRow& ) const = 0;
+  virtual void sentDifficultiesHeader( csvRow& ) const = 0;
+  virtual void sentDifficultiesToCSV( csvRow& ) const = 0;
+  virtual void infoHeader( csvRow& ) const = 0;
+  virtual void informationDensityToCSV( csvRow& ) const = 0;
+  virtual void coherenceHeader( csvRow& ) const = 0;
+  virtual void coherenceToCSV( csvRow& ) const = 0;
+  virtual void concreetHeader( csvRow& ) const = 0;
+  virtual void concreetToCSV( csvRow& ) const = 0;
+  virtual void persoonlijkheidHeader( csvRow& ) const = 0;
+  virtual void persoonlijkheidToCSV( csvRow& ) const = 0;
+  virtual void verbHeader( csvRow& ) const = 0;
+  virtual void verbToCSV( csvRow& ) const = 0;
+  virtual void imperativeHeader( csvRow& ) const = 0;
+  virtual void imperativeToCSV( csvRow& ) const = 0;
+  virtual void wordSortHeader( csvRow& ) const = 0;
+  virtual void wordSortToCSV( csvRow& ) const = 0;
+  virtual void prepPhraseHeader( csvRow& ) const = 0;
+  virtual void prepPhraseToCSV( csvRow& ) const = 0;
+  virtual void intensHeader( csvRow& ) const = 0;
+  virtual void intensToCSV( csvRow& ) const = 0;
+  virtual void formalHeader( csvRow& ) const = 0;
+  virtual void formalToCSV( csvRow& ) const = 0;
+  virtual void miscToCSV( csvRow& ) const = 0;
+  virtual void miscHeader( csvRow& ) const = 0;
   virtual double rarity( int ) const { return NAN; };
-  virtual void toCSV( std::ostream& ) const = 0;
+  virtual void toCSV( csvRow& ) const = 0;
   virtual void addMetrics() const = 0;
   virtual std::string text() const { return ""; };
   virtual std::string ltext() const { return ""; };
   virtual std::string Lemma() const { return ""; };
   virtual std::string llemma() const { return ""; };
+  virtual uint32_t ltextId() const { return 0; };
+  virtual uint32_t lemmaId() const { return 0; };
   virtual CGN::Type postag() const { return CGN::UNASS; };
   virtual CGN::Prop wordProperty() const { return CGN::NOTAWORD; };
   virtual Conn::Type getConnType() const { return Conn::NOCONN; };
@@ -93,7 +154,6 @@ struct basicStats {
     throw std::logic_error("setSitType() only valid for words" );
   };
   virtual Situation::Type getSitType() const { return Situation::NO_SIT; };
-  virtual std::vector<const wordStats*> collectWords() const = 0;
   virtual double get_al_gem() const { return NAN; };
   virtual double get_al_max() const { return NAN; };
   folia::FoliaElement* folia_node;
@@ -109,41 +169,44 @@ struct basicStats {
 
 
 struct wordStats : public basicStats {
-  wordStats( int, folia::Word*, const xmlNode*, const std::set<size_t>&, bool );
-  void CSVheader( std::ostream &, const std::string & ) const override;
-  void wordDifficultiesHeader( std::ostream & ) const override;
-  void wordDifficultiesToCSV( std::ostream & ) const override;
-  void sentDifficultiesHeader( std::ostream & ) const override{};
-  void sentDifficultiesToCSV( std::ostream & ) const override{};
-  void infoHeader( std::ostream & ) const override{};
-  void informationDensityToCSV( std::ostream & ) const override{};
-  void coherenceHeader( std::ostream & ) const override;
-  void coherenceToCSV( std::ostream & ) const override;
-  void concreetHeader( std::ostream & ) const override;
-  void concreetToCSV( std::ostream & ) const override;
-  void compoundHeader( std::ostream & ) const override;
-  void compoundToCSV( std::ostream & ) const override;
-  void persoonlijkheidHeader( std::ostream & ) const override;
-  void persoonlijkheidToCSV( std::ostream & ) const override;
-  void verbHeader( std::ostream & ) const override{};
-  void verbToCSV( std::ostream & ) const override{};
-  void imperativeHeader( std::ostream & ) const override{};
-  void imperativeToCSV( std::ostream & ) const override{};
-  void wordSortHeader( std::ostream & ) const override;
-  void wordSortToCSV( std::ostream & ) const override;
-  void prepPhraseHeader( std::ostream & ) const override{};
-  void prepPhraseToCSV( std::ostream & ) const override{};
-  void intensHeader( std::ostream & ) const override{};
-  void intensToCSV( std::ostream & ) const override{};
-  void formalHeader( std::ostream & ) const override{};
-  void formalToCSV( std::ostream & ) const override{};
-  void miscHeader( std::ostream &os ) const override;
-  void miscToCSV( std::ostream & ) const override;
-  void toCSV( std::ostream & ) const override;
+  wordStats( int, folia::Word*, const sentenceAnnotations&, const xmlNode*,
+             const std::set<size_t>&, bool );
+  void CSVheader( csvRow&, const std::string & ) const override;
+  void wordDifficultiesHeader( csvRow& ) const override;
+  void wordDifficultiesToCSV( csvRow& ) const override;
+  void sentDifficultiesHeader( csvRow& ) const override{};
+  void sentDifficultiesToCSV( csvRow& ) const override{};
+  void infoHeader( csvRow& ) const override{};
+  void informationDensityToCSV( csvRow& ) const override{};
+  void coherenceHeader( csvRow& ) const override;
+  void coherenceToCSV( csvRow& ) const override;
+  void concreetHeader( csvRow& ) const override;
+  void concreetToCSV( csvRow& ) const override;
+  void compoundHeader( csvRow& ) const override;
+  void compoundToCSV( csvRow& ) const override;
+  void persoonlijkheidHeader( csvRow& ) const override;
+  void persoonlijkheidToCSV( csvRow& ) const override;
+  void verbHeader( csvRow& ) const override{};
+  void verbToCSV( csvRow& ) const override{};
+  void imperativeHeader( csvRow& ) const override{};
+  void imperativeToCSV( csvRow& ) const override{};
+  void wordSortHeader( csvRow& ) const override;
+  void wordSortToCSV( csvRow& ) const override;
+  void prepPhraseHeader( csvRow& ) const override{};
+  void prepPhraseToCSV( csvRow& ) const override{};
+  void intensHeader( csvRow& ) const override{};
+  void intensToCSV( csvRow& ) const override{};
+  void formalHeader( csvRow& ) const override{};
+  void formalToCSV( csvRow& ) const override{};
+  void miscHeader( csvRow& os ) const override;
+  void miscToCSV( csvRow& ) const override;
+  void toCSV( csvRow& ) const override;
   std::string text() const override { return word; };
   std::string ltext() const override { return l_word; };
   std::string Lemma() const override { return lemma; };
   std::string llemma() const override { return l_lemma; };
+  uint32_t ltextId() const override { return l_word.id(); };
+  uint32_t lemmaId() const override { return lemma.id(); };
   CGN::Type postag() const override { return tag; };
   Conn::Type getConnType() const override { return connType; };
   void setConnType( Conn::Type t ) override { connType = t; };
@@ -153,20 +216,20 @@ struct wordStats : public basicStats {
   Situation::Type getSitType() const override { return sitType; };
   void addMetrics() const override;
   bool checkContent( bool ) const;
-  Conn::Type checkConnective() const;
-  Situation::Type checkSituation() const;
+  Conn::Type checkConnective( const lemma_class& ) const;
+  Situation::Type checkSituation( const lemma_class& ) const;
   bool checkNominal( const xmlNode* ) const;
-  void setCGNProps( const folia::PosAnnotation* );
+  void setCGNProps( const posFeatures& );
   CGN::Prop wordProperty() const override { return prop; };
   void checkNoun();
   SEM::Type checkSemProps() const;
-  Intensify::Type checkIntensify(const xmlNode*) const;
-  Formal::Type checkFormal() const;
-  General::Type checkGeneralNoun() const;
-  General::Type checkGeneralVerb() const;
+  Intensify::Type checkIntensify( const xmlNode*, const lemma_class& ) const;
+  Formal::Type checkFormal( const lemma_class& ) const;
+  General::Type checkGeneralNoun( const lemma_class& ) const;
+  General::Type checkGeneralVerb( const lemma_class& ) const;
   Afk::Type checkAfk() const;
-  std::string checkMyClassification() const;
-  bool checkStoplist() const;
+  std::string checkMyClassification( const lemma_class& ) const;
+  bool checkStoplist( const lemma_class& ) const;
   bool checkPropNeg() const;
   bool checkMorphNeg() const;
   void prevalenceLookup();
@@ -175,39 +238,21 @@ struct wordStats : public basicStats {
   top_val topFreqLookup(const std::string&) const;
   int wordFreqLookup(const std::string&) const;
   void freqLookup();
-  void getSentenceOverlap( const std::vector<std::string>&, const std::vector<std::string>& );
+  void getSentenceOverlap( const OverlapWindow&, const OverlapWindow& );
   bool isOverlapCandidate() const;
-  std::vector<const wordStats *> collectWords() const override;
-  bool parseFail;
-  std::string word;
-  std::string l_word;
-  std::string pos;
+  interned_string word;
+  interned_string l_word;
+  interned_string pos;
   CGN::Type tag;
-  std::string lemma;
-  std::string full_lemma; // scheidbare ww hebben dit
-  std::string l_lemma;
+  interned_string lemma;
+  interned_string full_lemma; // scheidbare ww hebben dit
+  interned_string l_lemma;
   WWform wwform;
-  bool isPersRef;
-  bool isPronRef;
-  bool archaic;
-  bool isContent;
-  bool isContentStrict;
-  bool isNominal;
-  bool isOnder;
-  bool isImperative;
-  bool isBetr;
-  bool isPropNeg;
-  bool isMorphNeg;
   NER::Type nerProp;
   Conn::Type connType;
-  bool isMultiConn;
   Situation::Type sitType;
   double prevalenceP;
   double prevalenceZ;
-  bool f50;
-  bool f65;
-  bool f77;
-  bool f80;
   top_val top_freq;
   int word_freq;
   int lemma_freq;
@@ -226,13 +271,13 @@ struct wordStats : public basicStats {
   General::Type general_verb_type;
   Adverb::Type adverb_type;
   Adverb::SubType adverb_sub_type;
-  std::vector<std::string> morphemes;
-  std::multimap<DD_type,int> distances;
+  std::vector<interned_string> morphemes;
+  /// @brief only set for words with dependencies, shared by copies
+  std::shared_ptr<const DistanceStats> distances;
   Afk::Type afkType;
-  bool is_compound;
   int compound_parts;
-  std::string compound_head;
-  std::string compound_sat;
+  interned_string compound_head;
+  interned_string compound_sat;
   int charCntHead;
   int charCntSat;
   double word_freq_log_head;
@@ -241,253 +286,333 @@ struct wordStats : public basicStats {
   double word_freq_log_corr;
   top_val top_freq_head;
   top_val top_freq_sat;
-  std::string compstr;
-  bool on_stoplist;
-  std::string my_classification;
+  interned_string compstr;
+  interned_string my_classification;
+  // the flags, one bit each
+  bool parseFail : 1;
+  bool isPersRef : 1;
+  bool isPronRef : 1;
+  bool archaic : 1;
+  bool isContent : 1;
+  bool isContentStrict : 1;
+  bool isNominal : 1;
+  bool isOnder : 1;
+  bool isImperative : 1;
+  bool isBetr : 1;
+  bool isPropNeg : 1;
+  bool isMorphNeg : 1;
+  bool isMultiConn : 1;
+  bool f50 : 1;
+  bool f65 : 1;
+  bool f77 : 1;
+  bool f80 : 1;
+  bool is_compound : 1;
+  bool on_stoplist : 1;
 };
 
+/**
+ * The counters of a structStats that merge() simply adds up.
+ * They are declared from these tables, as one block of ints followed by
+ * one block of doubles, so merging is a straight run over adjacent
+ * fields that the compiler can vectorise. A new counter that only needs
+ * adding up goes into one of these tables.
+ */
+#define STRUCT_INT_SUMS(X) \
+  X( wordCnt ) \
+  X( wordInclCnt ) /* wordCnt including stopwords */ \
+  X( vdBvCnt ) \
+  X( vdNwCnt ) \
+  X( vdVrijCnt ) \
+  X( odBvCnt ) \
+  X( odNwCnt ) \
+  X( odVrijCnt ) \
+  X( infBvCnt ) \
+  X( infNwCnt ) \
+  X( infVrijCnt ) \
+  X( smainCnt ) \
+  X( ssubCnt ) \
+  X( sv1Cnt ) \
+  X( clauseCnt ) \
+  X( correctedClauseCnt ) \
+  X( smainCnjCnt ) \
+  X( ssubCnjCnt ) \
+  X( sv1CnjCnt ) \
+  X( presentCnt ) \
+  X( pastCnt ) \
+  X( subjonctCnt ) \
+  X( nameCnt ) \
+  X( nameInclCnt ) /* nameCnt including stopwords */ \
+  X( pron1Cnt ) \
+  X( pron2Cnt ) \
+  X( pron3Cnt ) \
+  X( passiveCnt ) \
+  X( modalCnt ) \
+  X( timeVCnt ) \
+  X( koppelCnt ) \
+  X( persRefCnt ) \
+  X( pronRefCnt ) \
+  X( archaicsCnt ) \
+  X( contentCnt ) \
+  X( contentInclCnt ) /* contentCnt including stopwords */ \
+  X( contentStrictCnt ) \
+  X( contentStrictInclCnt ) /* contentStrictCnt including stopwords */ \
+  X( nominalCnt ) \
+  X( adjCnt ) \
+  X( adjInclCnt ) /* adjCnt including stopwords */ \
+  X( vgCnt ) \
+  X( vnwCnt ) \
+  X( lidCnt ) \
+  X( vzCnt ) \
+  X( bwCnt ) \
+  X( twCnt ) \
+  X( nounCnt ) \
+  X( nounInclCnt ) /* nounCnt including stopwords */ \
+  X( verbCnt ) \
+  X( verbInclCnt ) /* verbCnt including stopwords */ \
+  X( tswCnt ) \
+  X( specCnt ) \
+  X( letCnt ) \
+  X( betrCnt ) \
+  X( bijwCnt ) \
+  X( complCnt ) \
+  X( mvFinInbedCnt ) \
+  X( infinComplBepCnt ) \
+  X( mvInbedCnt ) \
+  X( losBetrCnt ) \
+  X( losBijwCnt ) \
+  X( allConnCnt ) \
+  X( tempConnCnt ) \
+  X( opsomWgConnCnt ) \
+  X( opsomZinConnCnt ) \
+  X( contrastConnCnt ) \
+  X( compConnCnt ) \
+  X( causeConnCnt ) \
+  X( timeSitCnt ) \
+  X( spaceSitCnt ) \
+  X( causeSitCnt ) \
+  X( emoSitCnt ) \
+  X( propNegCnt ) \
+  X( morphNegCnt ) \
+  X( multiNegCnt ) \
+  X( wordOverlapCnt ) \
+  X( lemmaOverlapCnt ) \
+  X( prevalenceCovered ) \
+  X( prevalenceContentCovered ) \
+  X( f50Cnt ) \
+  X( f65Cnt ) \
+  X( f77Cnt ) \
+  X( f80Cnt ) \
+  X( top1000Cnt ) \
+  X( top2000Cnt ) \
+  X( top3000Cnt ) \
+  X( top5000Cnt ) \
+  X( top10000Cnt ) \
+  X( top20000Cnt ) \
+  X( top1000ContentCnt ) \
+  X( top2000ContentCnt ) \
+  X( top3000ContentCnt ) \
+  X( top5000ContentCnt ) \
+  X( top10000ContentCnt ) \
+  X( top20000ContentCnt ) \
+  X( top1000ContentStrictCnt ) \
+  X( top2000ContentStrictCnt ) \
+  X( top3000ContentStrictCnt ) \
+  X( top5000ContentStrictCnt ) \
+  X( top10000ContentStrictCnt ) \
+  X( top20000ContentStrictCnt ) \
+  X( intensCnt ) \
+  X( intensBvnwCnt ) \
+  X( intensBvbwCnt ) \
+  X( intensBwCnt ) \
+  X( intensCombiCnt ) \
+  X( intensNwCnt ) \
+  X( intensTussCnt ) \
+  X( intensWwCnt ) \
+  X( formalCnt ) \
+  X( formalBvnwCnt ) \
+  X( formalBwCnt ) \
+  X( formalVgwCnt ) \
+  X( formalVnwCnt ) \
+  X( formalVzCnt ) \
+  X( formalVzgCnt ) \
+  X( formalWwCnt ) \
+  X( formalZnwCnt ) \
+  X( generalNounCnt ) \
+  X( generalNounSepCnt ) \
+  X( generalNounRelCnt ) \
+  X( generalNounActCnt ) \
+  X( generalNounKnowCnt ) \
+  X( generalNounDiscCnt ) \
+  X( generalNounDeveCnt ) \
+  X( generalVerbCnt ) \
+  X( generalVerbSepCnt ) \
+  X( generalVerbRelCnt ) \
+  X( generalVerbActCnt ) \
+  X( generalVerbKnowCnt ) \
+  X( generalVerbDiscCnt ) \
+  X( generalVerbDeveCnt ) \
+  X( generalAdverbCnt ) \
+  X( specificAdverbCnt ) \
+  X( broadNounCnt ) \
+  X( strictNounCnt ) \
+  X( broadAdjCnt ) \
+  X( strictAdjCnt ) \
+  X( subjectiveAdjCnt ) \
+  X( abstractWwCnt ) \
+  X( concreteWwCnt ) \
+  X( undefinedWwCnt ) \
+  X( undefinedATPCnt ) \
+  X( stateCnt ) \
+  X( actionCnt ) \
+  X( processCnt ) \
+  X( humanAdjCnt ) \
+  X( emoAdjCnt ) \
+  X( nonhumanAdjCnt ) \
+  X( shapeAdjCnt ) \
+  X( colorAdjCnt ) \
+  X( matterAdjCnt ) \
+  X( soundAdjCnt ) \
+  X( nonhumanOtherAdjCnt ) \
+  X( techAdjCnt ) \
+  X( timeAdjCnt ) \
+  X( placeAdjCnt ) \
+  X( specPosAdjCnt ) \
+  X( specNegAdjCnt ) \
+  X( posAdjCnt ) \
+  X( negAdjCnt ) \
+  X( evaluativeAdjCnt ) \
+  X( epiPosAdjCnt ) \
+  X( epiNegAdjCnt ) \
+  X( abstractAdjCnt ) \
+  X( undefinedNounCnt ) \
+  X( uncoveredNounCnt ) \
+  X( undefinedAdjCnt ) \
+  X( uncoveredAdjCnt ) \
+  X( uncoveredVerbCnt ) \
+  X( humanCnt ) \
+  X( nonHumanCnt ) \
+  X( artefactCnt ) \
+  X( concrotherCnt ) \
+  X( substanceConcCnt ) \
+  X( foodcareCnt ) \
+  X( timeCnt ) \
+  X( placeCnt ) \
+  X( measureCnt ) \
+  X( dynamicConcCnt ) \
+  X( substanceAbstrCnt ) \
+  X( dynamicAbstrCnt ) \
+  X( nonDynamicCnt ) \
+  X( institutCnt ) \
+  X( npCnt ) \
+  X( indefNpCnt ) \
+  X( npSize ) \
+  X( vcModCnt ) \
+  X( vcModSingleCnt ) \
+  X( adjNpModCnt ) \
+  X( npModCnt ) \
+  X( smallCnjCnt ) \
+  X( smallCnjExtraCnt ) \
+  X( dLevel_gt4 ) \
+  X( impCnt ) \
+  X( questCnt ) \
+  X( prepExprCnt ) \
+  X( nerCnt ) \
+  X( compoundCnt ) \
+  X( compound3Cnt ) \
+  X( charCntNoun ) \
+  X( charCntNonComp ) \
+  X( charCntComp ) \
+  X( charCntHead ) \
+  X( charCntSat ) \
+  X( charCntNounCorr ) \
+  X( charCntCorr ) \
+  X( top1000CntNoun ) \
+  X( top1000CntNonComp ) \
+  X( top1000CntComp ) \
+  X( top1000CntHead ) \
+  X( top1000CntSat ) \
+  X( top1000CntNounCorr ) \
+  X( top1000CntCorr ) \
+  X( top5000CntNoun ) \
+  X( top5000CntNonComp ) \
+  X( top5000CntComp ) \
+  X( top5000CntHead ) \
+  X( top5000CntSat ) \
+  X( top5000CntNounCorr ) \
+  X( top5000CntCorr ) \
+  X( top20000CntNoun ) \
+  X( top20000CntNonComp ) \
+  X( top20000CntComp ) \
+  X( top20000CntHead ) \
+  X( top20000CntSat ) \
+  X( top20000CntNounCorr ) \
+  X( top20000CntCorr )
+
+#define STRUCT_DOUBLE_SUMS(X) \
+  X( prevalenceP ) \
+  X( prevalenceZ ) \
+  X( prevalenceContentP ) \
+  X( prevalenceContentZ ) \
+  X( word_freq ) \
+  X( word_freq_n ) \
+  X( word_freq_strict ) \
+  X( word_freq_n_strict ) \
+  X( lemma_freq ) \
+  X( lemma_freq_n ) \
+  X( lemma_freq_strict ) \
+  X( lemma_freq_n_strict ) \
+  X( avg_prob10_fwd ) \
+  X( avg_prob10_fwd_content ) \
+  X( avg_prob10_fwd_ex_names ) \
+  X( avg_prob10_fwd_content_ex_names ) \
+  X( avg_prob10_bwd ) \
+  X( avg_prob10_bwd_content ) \
+  X( avg_prob10_bwd_ex_names ) \
+  X( avg_prob10_bwd_content_ex_names ) \
+  X( entropy_fwd ) \
+  X( entropy_fwd_norm ) \
+  X( entropy_bwd ) \
+  X( entropy_bwd_norm ) \
+  X( perplexity_fwd ) \
+  X( perplexity_fwd_norm ) \
+  X( perplexity_bwd ) \
+  X( perplexity_bwd_norm ) \
+  X( word_freq_log_noun ) \
+  X( word_freq_log_non_comp ) \
+  X( word_freq_log_comp ) \
+  X( word_freq_log_head ) \
+  X( word_freq_log_sat ) \
+  X( word_freq_log_head_sat ) \
+  X( word_freq_log_noun_corr ) \
+  X( word_freq_log_corr ) \
+  X( word_freq_log_corr_strict ) \
+  X( word_freq_log_n_corr ) \
+  X( word_freq_log_n_corr_strict )
+
 struct structStats: public basicStats {
   structStats( int index, folia::FoliaElement* el, const std::string& cat ):
     basicStats( index, el, cat ),
-    wordCnt(0),
-    wordInclCnt(0), // wordCnt including stopwords
+#define INIT_SUM( name ) name(0),
+    STRUCT_INT_SUMS( INIT_SUM )
+    STRUCT_DOUBLE_SUMS( INIT_SUM )
+#undef INIT_SUM
     sentCnt(0),
     parseFailCnt(0),
-    vdBvCnt(0),
-    vdNwCnt(0),
-    vdVrijCnt(0),
-    odBvCnt(0),
-    odNwCnt(0),
-    odVrijCnt(0),
-    infBvCnt(0),
-    infNwCnt(0),
-    infVrijCnt(0),
-    smainCnt(0),
-    ssubCnt(0),
-    sv1Cnt(0),
-    clauseCnt(0),
-    correctedClauseCnt(0),
-    smainCnjCnt(0),
-    ssubCnjCnt(0),
-    sv1CnjCnt(0),
-    presentCnt(0),
-    pastCnt(0),
-    subjonctCnt(0),
-    nameCnt(0),
-    nameInclCnt(0), // nameCnt including stopwords
-    pron1Cnt(0),
-    pron2Cnt(0),
-    pron3Cnt(0),
-    passiveCnt(0),
-    modalCnt(0),
-    timeVCnt(0),
-    koppelCnt(0),
-    persRefCnt(0),
-    pronRefCnt(0),
-    archaicsCnt(0),
-    contentCnt(0),
-    contentInclCnt(0), // contentCnt including stopwords
-    contentStrictCnt(0),
-    contentStrictInclCnt(0), // contentStrictCnt including stopwords
-    nominalCnt(0),
-    adjCnt(0),
-    adjInclCnt(0), // adjCnt including stopwords
-    vgCnt(0),
-    vnwCnt(0),
-    lidCnt(0),
-    vzCnt(0),
-    bwCnt(0),
-    twCnt(0),
-    nounCnt(0),
-    nounInclCnt(0), // nounCnt including stopwords
-    verbCnt(0),
-    verbInclCnt(0), // verbCnt including stopwords
-    tswCnt(0),
-    specCnt(0),
-    letCnt(0),
-    betrCnt(0),
-    bijwCnt(0),
-    complCnt(0),
-    mvFinInbedCnt(0),
-    infinComplBepCnt(0),
-    mvInbedCnt(0),
-    losBetrCnt(0),
-    losBijwCnt(0),
-    allConnCnt(0),
-    tempConnCnt(0),
-    opsomWgConnCnt(0),
-    opsomZinConnCnt(0),
-    contrastConnCnt(0),
-    compConnCnt(0),
-    causeConnCnt(0),
-    timeSitCnt(0),
-    spaceSitCnt(0),
-    causeSitCnt(0),
-    emoSitCnt(0),
-    propNegCnt(0),
-    morphNegCnt(0),
-    multiNegCnt(0),
-    wordOverlapCnt(0),
-    lemmaOverlapCnt(0),
-    prevalenceP(0),
-    prevalenceZ(0),
-    prevalenceContentP(0),
-    prevalenceContentZ(0),
-    prevalenceCovered(0),
-    prevalenceContentCovered(0),
-    f50Cnt(0),
-    f65Cnt(0),
-    f77Cnt(0),
-    f80Cnt(0),
-    top1000Cnt(0),
-    top2000Cnt(0),
-    top3000Cnt(0),
-    top5000Cnt(0),
-    top10000Cnt(0),
-    top20000Cnt(0),
-    top1000ContentCnt(0),
-    top2000ContentCnt(0),
-    top3000ContentCnt(0),
-    top5000ContentCnt(0),
-    top10000ContentCnt(0),
-    top20000ContentCnt(0),
-    top1000ContentStrictCnt(0),
-    top2000ContentStrictCnt(0),
-    top3000ContentStrictCnt(0),
-    top5000ContentStrictCnt(0),
-    top10000ContentStrictCnt(0),
-    top20000ContentStrictCnt(0),
-    word_freq(0),
-    word_freq_n(0),
-    word_freq_strict(0),
-    word_freq_n_strict(0),
     word_freq_log(NAN),
     word_freq_log_n(NAN),
     word_freq_log_strict(NAN),
     word_freq_log_n_strict(NAN),
-    lemma_freq(0),
-    lemma_freq_n(0),
-    lemma_freq_strict(0),
-    lemma_freq_n_strict(0),
     lemma_freq_log(NAN),
     lemma_freq_log_n(NAN),
     lemma_freq_log_strict(NAN),
     lemma_freq_log_n_strict(NAN),
-    avg_prob10_fwd(0),
-    avg_prob10_fwd_content(0),
-    avg_prob10_fwd_ex_names(0),
-    avg_prob10_fwd_content_ex_names(0),
-    avg_prob10_bwd(0),
-    avg_prob10_bwd_content(0),
-    avg_prob10_bwd_ex_names(0),
-    avg_prob10_bwd_content_ex_names(0),
-    entropy_fwd(0),
-    entropy_fwd_norm(0),
-    entropy_bwd(0),
-    entropy_bwd_norm(0),
-    perplexity_fwd(0),
-    perplexity_fwd_norm(0),
-    perplexity_bwd(0),
-    perplexity_bwd_norm(0),
     al_gem(NAN),
     al_max(NAN),
-    intensCnt(0),
-    intensBvnwCnt(0),
-    intensBvbwCnt(0),
-    intensBwCnt(0),
-    intensCombiCnt(0),
-    intensNwCnt(0),
-    intensTussCnt(0),
-    intensWwCnt(0),
-    formalCnt(0),
-    formalBvnwCnt(0),
-    formalBwCnt(0),
-    formalVgwCnt(0),
-    formalVnwCnt(0),
-    formalVzCnt(0),
-    formalVzgCnt(0),
-    formalWwCnt(0),
-    formalZnwCnt(0),
-    generalNounCnt(0),
-    generalNounSepCnt(0),
-    generalNounRelCnt(0),
-    generalNounActCnt(0),
-    generalNounKnowCnt(0),
-    generalNounDiscCnt(0),
-    generalNounDeveCnt(0),
-    generalVerbCnt(0),
-    generalVerbSepCnt(0),
-    generalVerbRelCnt(0),
-    generalVerbActCnt(0),
-    generalVerbKnowCnt(0),
-    generalVerbDiscCnt(0),
-    generalVerbDeveCnt(0),
-    generalAdverbCnt(0),
-    specificAdverbCnt(0),
-    broadNounCnt(0),
-    strictNounCnt(0),
-    broadAdjCnt(0),
-    strictAdjCnt(0),
-    subjectiveAdjCnt(0),
-    abstractWwCnt(0),
-    concreteWwCnt(0),
-    undefinedWwCnt(0),
-    undefinedATPCnt(0),
-    stateCnt(0),
-    actionCnt(0),
-    processCnt(0),
-    humanAdjCnt(0),
-    emoAdjCnt(0),
-    nonhumanAdjCnt(0),
-    shapeAdjCnt(0),
-    colorAdjCnt(0),
-    matterAdjCnt(0),
-    soundAdjCnt(0),
-    nonhumanOtherAdjCnt(0),
-    techAdjCnt(0),
-    timeAdjCnt(0),
-    placeAdjCnt(0),
-    specPosAdjCnt(0),
-    specNegAdjCnt(0),
-    posAdjCnt(0),
-    negAdjCnt(0),
-    evaluativeAdjCnt(0),
-    epiPosAdjCnt(0),
-    epiNegAdjCnt(0),
-    abstractAdjCnt(0),
-    undefinedNounCnt(0),
-    uncoveredNounCnt(0),
-    undefinedAdjCnt(0),
-    uncoveredAdjCnt(0),
-    uncoveredVerbCnt(0),
-    humanCnt(0),
-    nonHumanCnt(0),
-    artefactCnt(0),
-    concrotherCnt(0),
-    substanceConcCnt(0),
-    foodcareCnt(0),
-    timeCnt(0),
-    placeCnt(0),
-    measureCnt(0),
-    dynamicConcCnt(0),
-    substanceAbstrCnt(0),
-    dynamicAbstrCnt(0),
-    nonDynamicCnt(0),
-    institutCnt(0),
-    npCnt(0),
-    indefNpCnt(0),
-    npSize(0),
-    vcModCnt(0),
-    vcModSingleCnt(0),
-    adjNpModCnt(0),
-    npModCnt(0),
-    smallCnjCnt(0),
-    smallCnjExtraCnt(0),
+    al_count(0),
+    al_gem_sum(0),
+    al_max_sum(0),
     dLevel(-1),
-    dLevel_gt4(0),
-    impCnt(0),
-    questCnt(0),
-    prepExprCnt(0),
+    heads(),
     word_mtld(0),
     lemma_mtld(0),
     content_mtld(0),
@@ -504,353 +629,101 @@ struct structStats: public basicStats {
     ruimte_sit_mtld(0),
     cause_sit_mtld(0),
     emotion_sit_mtld(0),
-    nerCnt(0),
-    compoundCnt(0),
-    compound3Cnt(0),
-    charCntNoun(0),
-    charCntNonComp(0),
-    charCntComp(0),
-    charCntHead(0),
-    charCntSat(0),
-    charCntNounCorr(0),
-    charCntCorr(0),
-    word_freq_log_noun(0),
-    word_freq_log_non_comp(0),
-    word_freq_log_comp(0),
-    word_freq_log_head(0),
-    word_freq_log_sat(0),
-    word_freq_log_head_sat(0),
-    word_freq_log_noun_corr(0),
-    word_freq_log_corr(0),
-    word_freq_log_corr_strict(0),
-    word_freq_log_n_corr(0),
-    word_freq_log_n_corr_strict(0),
-    top1000CntNoun(0),
-    top1000CntNonComp(0),
-    top1000CntComp(0),
-    top1000CntHead(0),
-    top1000CntSat(0),
-    top1000CntNounCorr(0),
-    top1000CntCorr(0),
-    top5000CntNoun(0),
-    top5000CntNonComp(0),
-    top5000CntComp(0),
-    top5000CntHead(0),
-    top5000CntSat(0),
-    top5000CntNounCorr(0),
-    top5000CntCorr(0),
-    top20000CntNoun(0),
-    top20000CntNonComp(0),
-    top20000CntComp(0),
-    top20000CntHead(0),
-    top20000CntSat(0),
-    top20000CntNounCorr(0),
-    top20000CntCorr(0),
+    ners(),
+    afks(),
     rarityLevel(0),
-    overlapSize(0)
+    overlapSize(0),
+    all_words(0),
+    first_word(0),
+    last_word(0)
  {};
-  ~structStats();
   void addMetrics() const override;
-  void topPredictorsHeader( std::ostream& ) const;
-  void topPredictorsToCSV( std::ostream& ) const;
-  void wordDifficultiesHeader( std::ostream & ) const override;
-  void wordDifficultiesToCSV( std::ostream & ) const override;
-  void compoundHeader( std::ostream & ) const override;
-  void compoundToCSV( std::ostream & ) const override;
-  void sentDifficultiesHeader( std::ostream & ) const override;
-  void sentDifficultiesToCSV( std::ostream & ) const override;
-  void infoHeader( std::ostream & ) const override;
-  void informationDensityToCSV( std::ostream & ) const override;
-  void coherenceHeader( std::ostream & ) const override;
-  void coherenceToCSV( std::ostream & ) const override;
-  void concreetHeader( std::ostream & ) const override;
-  void concreetToCSV( std::ostream & ) const override;
-  void persoonlijkheidHeader( std::ostream & ) const override;
-  void persoonlijkheidToCSV( std::ostream & ) const override;
-  void verbHeader( std::ostream & ) const override;
-  void verbToCSV( std::ostream & ) const override;
-  void imperativeHeader( std::ostream & ) const override;
-  void imperativeToCSV( std::ostream & ) const override;
-  void wordSortHeader( std::ostream & ) const override;
-  void wordSortToCSV( std::ostream & ) const override;
-  void prepPhraseHeader( std::ostream & ) const override;
-  void prepPhraseToCSV( std::ostream & ) const override;
-  void intensHeader( std::ostream & ) const override;
-  void intensToCSV( std::ostream & ) const override;
-  void formalHeader( std::ostream & ) const override;
-  void formalToCSV( std::ostream & ) const override;
-  void miscHeader( std::ostream & ) const override;
-  void miscToCSV( std::ostream & ) const override;
-  void CSVheader( std::ostream &, const std::string & ) const override;
-  void toCSV( std::ostream & ) const override;
+  void topPredictorsHeader( csvRow& ) const;
+  void topPredictorsToCSV( csvRow& ) const;
+  void wordDifficultiesHeader( csvRow& ) const override;
+  void wordDifficultiesToCSV( csvRow& ) const override;
+  void compoundHeader( csvRow& ) const override;
+  void compoundToCSV( csvRow& ) const override;
+  void sentDifficultiesHeader( csvRow& ) const override;
+  void sentDifficultiesToCSV( csvRow& ) const override;
+  void infoHeader( csvRow& ) const override;
+  void informationDensityToCSV( csvRow& ) const override;
+  void coherenceHeader( csvRow& ) const override;
+  void coherenceToCSV( csvRow& ) const override;
+  void concreetHeader( csvRow& ) const override;
+  void concreetToCSV( csvRow& ) const override;
+  void persoonlijkheidHeader( csvRow& ) const override;
+  void persoonlijkheidToCSV( csvRow& ) const override;
+  void verbHeader( csvRow& ) const override;
+  void verbToCSV( csvRow& ) const override;
+  void imperativeHeader( csvRow& ) const override;
+  void imperativeToCSV( csvRow& ) const override;
+  void wordSortHeader( csvRow& ) const override;
+  void wordSortToCSV( csvRow& ) const override;
+  void prepPhraseHeader( csvRow& ) const override;
+  void prepPhraseToCSV( csvRow& ) const override;
+  void intensHeader( csvRow& ) const override;
+  void intensToCSV( csvRow& ) const override;
+  void formalHeader( csvRow& ) const override;
+  void formalToCSV( csvRow& ) const override;
+  void miscHeader( csvRow& ) const override;
+  void miscToCSV( csvRow& ) const override;
+  void CSVheader( csvRow&, const std::string & ) const override;
+  void toCSV( csvRow& ) const override;
   void merge( structStats* );
   virtual bool isSentence() const { return false; };
   virtual bool isDocument() const { return false; };
   virtual int word_overlapCnt() const { return -1; };
   virtual int lemma_overlapCnt() const { return -1; };
-  std::vector<const wordStats *> collectWords() const override;
+  word_range words() const;
+  void setWordRange( const word_index&, size_t );
   double get_al_gem() const override { return al_gem; };
   double get_al_max() const override { return al_max; };
   virtual double getMeanAL() const;
   virtual double getHighestAL() const;
   void calculate_MTLDs();
+  void calculate_MTLDs( std::vector<mtld_series>& );
   std::string text;
-  int wordCnt;
-  int wordInclCnt;
+#define DECLARE_SUM( name ) int name;
+  STRUCT_INT_SUMS( DECLARE_SUM )
+#undef DECLARE_SUM
+#define DECLARE_SUM( name ) double name;
+  STRUCT_DOUBLE_SUMS( DECLARE_SUM )
+#undef DECLARE_SUM
   int sentCnt;
   int parseFailCnt;
-  int vdBvCnt;
-  int vdNwCnt;
-  int vdVrijCnt;
-  int odBvCnt;
-  int odNwCnt;
-  int odVrijCnt;
-  int infBvCnt;
-  int infNwCnt;
-  int infVrijCnt;
-  int smainCnt;
-  int ssubCnt;
-  int sv1Cnt;
-  int clauseCnt;
-  int correctedClauseCnt;
-  int smainCnjCnt;
-  int ssubCnjCnt;
-  int sv1CnjCnt;
-  int presentCnt;
-  int pastCnt;
-  int subjonctCnt;
-  int nameCnt;
-  int nameInclCnt;
-  int pron1Cnt;
-  int pron2Cnt;
-  int pron3Cnt;
-  int passiveCnt;
-  int modalCnt;
-  int timeVCnt;
-  int koppelCnt;
-  int persRefCnt;
-  int pronRefCnt;
-  int archaicsCnt;
-  int contentCnt;
-  int contentInclCnt;
-  int contentStrictCnt;
-  int contentStrictInclCnt;
-  int nominalCnt;
-  int adjCnt;
-  int adjInclCnt;
-  int vgCnt;
-  int vnwCnt;
-  int lidCnt;
-  int vzCnt;
-  int bwCnt;
-  int twCnt;
-  int nounCnt;
-  int nounInclCnt;
-  int verbCnt;
-  int verbInclCnt;
-  int tswCnt;
-  int specCnt;
-  int letCnt;
-  int betrCnt;
-  int bijwCnt;
-  int complCnt;
-  int mvFinInbedCnt;
-  int infinComplBepCnt;
-  int mvInbedCnt;
-  int losBetrCnt;
-  int losBijwCnt;
-  int allConnCnt;
-  int tempConnCnt;
-  int opsomWgConnCnt;
-  int opsomZinConnCnt;
-  int contrastConnCnt;
-  int compConnCnt;
-  int causeConnCnt;
-  int timeSitCnt;
-  int spaceSitCnt;
-  int causeSitCnt;
-  int emoSitCnt;
-  int propNegCnt;
-  int morphNegCnt;
-  int multiNegCnt;
-  int wordOverlapCnt;
-  int lemmaOverlapCnt;
-  double prevalenceP;
-  double prevalenceZ;
-  double prevalenceContentP;
-  double prevalenceContentZ;
-  int prevalenceCovered;
-  int prevalenceContentCovered;
-  int f50Cnt;
-  int f65Cnt;
-  int f77Cnt;
-  int f80Cnt;
-  int top1000Cnt;
-  int top2000Cnt;
-  int top3000Cnt;
-  int top5000Cnt;
-  int top10000Cnt;
-  int top20000Cnt;
-  int top1000ContentCnt;
-  int top2000ContentCnt;
-  int top3000ContentCnt;
-  int top5000ContentCnt;
-  int top10000ContentCnt;
-  int top20000ContentCnt;
-  int top1000ContentStrictCnt;
-  int top2000ContentStrictCnt;
-  int top3000ContentStrictCnt;
-  int top5000ContentStrictCnt;
-  int top10000ContentStrictCnt;
-  int top20000ContentStrictCnt;
-  double word_freq;
-  double word_freq_n;
-  double word_freq_strict;
-  double word_freq_n_strict;
   double word_freq_log;
   double word_freq_log_n;
   double word_freq_log_strict;
   double word_freq_log_n_strict;
-  double lemma_freq;
-  double lemma_freq_n;
-  double lemma_freq_strict;
-  double lemma_freq_n_strict;
   double lemma_freq_log;
   double lemma_freq_log_n;
   double lemma_freq_log_strict;
   double lemma_freq_log_n_strict;
-  double avg_prob10_fwd;
-  double avg_prob10_fwd_content;
-  double avg_prob10_fwd_ex_names;
-  double avg_prob10_fwd_content_ex_names;
-  double avg_prob10_bwd;
-  double avg_prob10_bwd_content;
-  double avg_prob10_bwd_ex_names;
-  double avg_prob10_bwd_content_ex_names;
-  double entropy_fwd;
-  double entropy_fwd_norm;
-  double entropy_bwd;
-  double entropy_bwd_norm;
-  double perplexity_fwd;
-  double perplexity_fwd_norm;
-  double perplexity_bwd;
-  double perplexity_bwd_norm;
   double al_gem;
   double al_max;
-  int intensCnt;
-  int intensBvnwCnt;
-  int intensBvbwCnt;
-  int intensBwCnt;
-  int intensCombiCnt;
-  int intensNwCnt;
-  int intensTussCnt;
-  int intensWwCnt;
-  int formalCnt;
-  int formalBvnwCnt;
-  int formalBwCnt;
-  int formalVgwCnt;
-  int formalVnwCnt;
-  int formalVzCnt;
-  int formalVzgCnt;
-  int formalWwCnt;
-  int formalZnwCnt;
-  int generalNounCnt;
-  int generalNounSepCnt;
-  int generalNounRelCnt;
-  int generalNounActCnt;
-  int generalNounKnowCnt;
-  int generalNounDiscCnt;
-  int generalNounDeveCnt;
-  int generalVerbCnt;
-  int generalVerbSepCnt;
-  int generalVerbRelCnt;
-  int generalVerbActCnt;
-  int generalVerbKnowCnt;
-  int generalVerbDiscCnt;
-  int generalVerbDeveCnt;
-  int generalAdverbCnt;
-  int specificAdverbCnt;
-  int broadNounCnt;
-  int strictNounCnt;
-  int broadAdjCnt;
-  int strictAdjCnt;
-  int subjectiveAdjCnt;
-  int abstractWwCnt;
-  int concreteWwCnt;
-  int undefinedWwCnt;
-  int undefinedATPCnt;
-  int stateCnt;
-  int actionCnt;
-  int processCnt;
-  int humanAdjCnt;
-  int emoAdjCnt;
-  int nonhumanAdjCnt;
-  int shapeAdjCnt;
-  int colorAdjCnt;
-  int matterAdjCnt;
-  int soundAdjCnt;
-  int nonhumanOtherAdjCnt;
-  int techAdjCnt;
-  int timeAdjCnt;
-  int placeAdjCnt;
-  int specPosAdjCnt;
-  int specNegAdjCnt;
-  int posAdjCnt;
-  int negAdjCnt;
-  int evaluativeAdjCnt;
-  int epiPosAdjCnt;
-  int epiNegAdjCnt;
-  int abstractAdjCnt;
-  int undefinedNounCnt;
-  int uncoveredNounCnt;
-  int undefinedAdjCnt;
-  int uncoveredAdjCnt;
-  int uncoveredVerbCnt;
-  int humanCnt;
-  int nonHumanCnt;
-  int artefactCnt;
-  int concrotherCnt;
-  int substanceConcCnt;
-  int foodcareCnt;
-  int timeCnt;
-  int placeCnt;
-  int measureCnt;
-  int dynamicConcCnt;
-  int substanceAbstrCnt;
-  int dynamicAbstrCnt;
-  int nonDynamicCnt;
-  int institutCnt;
-  int npCnt;
-  int indefNpCnt;
-  int npSize;
-  int vcModCnt;
-  int vcModSingleCnt;
-  int adjNpModCnt;
-  int npModCnt;
-  int smallCnjCnt;
-  int smallCnjExtraCnt;
+  // the AL of the merged children, so they are not needed afterwards
+  int al_count;
+  double al_gem_sum;
+  double al_max_sum;
   int dLevel;
-  int dLevel_gt4;
-  int impCnt;
-  int questCnt;
-  int prepExprCnt;
-  std::map<CGN::Type,int> heads;
-  std::map<std::string,int> unique_names;
-  std::map<std::string,int> unique_contents;
-  std::map<std::string,int> unique_contents_strict;
-  std::map<std::string,int> unique_tijd_sits;
-  std::map<std::string,int> unique_ruimte_sits;
-  std::map<std::string,int> unique_cause_sits;
-  std::map<std::string,int> unique_emotion_sits;
-  std::map<std::string,int> unique_all_conn;
-  std::map<std::string,int> unique_temp_conn;
-  std::map<std::string,int> unique_reeks_wg_conn;
-  std::map<std::string,int> unique_reeks_zin_conn;
-  std::map<std::string,int> unique_contr_conn;
-  std::map<std::string,int> unique_comp_conn;
-  std::map<std::string,int> unique_cause_conn;
-  std::map<std::string,int> unique_words;
-  std::map<std::string,int> unique_lemmas;
+  std::array<int, CGN::WW + 1> heads;
+  IdCounter unique_names;
+  IdCounter unique_contents;
+  IdCounter unique_contents_strict;
+  IdCounter unique_tijd_sits;
+  IdCounter unique_ruimte_sits;
+  IdCounter unique_cause_sits;
+  IdCounter unique_emotion_sits;
+  IdCounter unique_all_conn;
+  IdCounter unique_temp_conn;
+  IdCounter unique_reeks_wg_conn;
+  IdCounter unique_reeks_zin_conn;
+  IdCounter unique_contr_conn;
+  IdCounter unique_comp_conn;
+  IdCounter unique_cause_conn;
+  IdCounter unique_words;
+  IdCounter unique_lemmas;
   double word_mtld;
   double lemma_mtld;
   double content_mtld;
@@ -867,72 +740,35 @@ struct structStats: public basicStats {
   double ruimte_sit_mtld;
   double cause_sit_mtld;
   double emotion_sit_mtld;
-  std::map<NER::Type, int> ners;
-  int nerCnt;
-  std::map<Afk::Type, int> afks;
-  std::multimap<DD_type,int> distances;
-  int compoundCnt;
-  int compound3Cnt;
-  int charCntNoun;
-  int charCntNonComp;
-  int charCntComp;
-  int charCntHead;
-  int charCntSat;
-  int charCntNounCorr;
-  int charCntCorr;
-  double word_freq_log_noun;
-  double word_freq_log_non_comp;
-  double word_freq_log_comp;
-  double word_freq_log_head;
-  double word_freq_log_sat;
-  double word_freq_log_head_sat;
-  double word_freq_log_noun_corr;
-  double word_freq_log_corr;
-  double word_freq_log_corr_strict;
-  double word_freq_log_n_corr;
-  double word_freq_log_n_corr_strict;
-  int top1000CntNoun;
-  int top1000CntNonComp;
-  int top1000CntComp;
-  int top1000CntHead;
-  int top1000CntSat;
-  int top1000CntNounCorr;
-  int top1000CntCorr;
-  int top5000CntNoun;
-  int top5000CntNonComp;
-  int top5000CntComp;
-  int top5000CntHead;
-  int top5000CntSat;
-  int top5000CntNounCorr;
-  int top5000CntCorr;
-  int top20000CntNoun;
-  int top20000CntNonComp;
-  int top20000CntComp;
-  int top20000CntHead;
-  int top20000CntSat;
-  int top20000CntNounCorr;
-  int top20000CntCorr;
+  std::array<int, NER::PRO_I + 1> ners;
+  std::array<int, Afk::GENERIEK_A + 1> afks;
+  DistanceStats distances;
   int rarityLevel;
   unsigned int overlapSize;
   std::map<std::string,int> my_classification;
+private:
+  const word_index *all_words;
+  size_t first_word;
+  size_t last_word;
 };
 
 
 struct sentStats : public structStats {
-  sentStats( const std::string&, int, folia::Sentence*, const sentStats* );
+  sentStats( const std::string&, int, folia::Sentence*, const sentStats*,
+             StatsArena&, word_index& );
   bool isSentence() const override { return true; };
-  void resolveConnectives();
-  void resolveSituations();
-  void resolveMultiWordIntensify();
-  void resolveMultiWordFormal();
+  void resolveConnectives( const PhraseMatches& );
+  void resolveSituations( const PhraseMatches& );
+  void resolveMultiWordIntensify( const PhraseMatches& );
+  void resolveMultiWordFormal( const PhraseMatches& );
   // void resolveMultiWordAfks();
   void addMetrics() const override;
   bool checkAls( size_t );
   double getMeanAL() const override;
   double getHighestAL() const override;
-  Conn::Type checkMultiConnectives( const std::string& );
-  Situation::Type checkMultiSituations( const std::string& );
-  void resolvePrepExpr();
+  Conn::Type checkMultiConnectives( const PhraseMatches&, size_t, size_t );
+  Situation::Type checkMultiSituations( const PhraseMatches&, size_t, size_t );
+  void resolvePrepExpr( const PhraseMatches& );
   void resolveAdverbials( xmlDoc* );
   void resolveRelativeClauses( xmlDoc* );
   void resolveFiniteVerbs( xmlDoc* );
@@ -944,48 +780,83 @@ struct sentStats : public structStats {
 
 
 struct parStats: public structStats {
-  parStats( const std::string&, int, folia::Paragraph* );
+  parStats( const std::string&, int, folia::Paragraph*, StatsArena&,
+            word_index& );
   void addMetrics() const override;
 };
 
 
+class CorpusWriter;
+class ColumnarWriter;
+class spoolFile;
+
+const std::vector<std::string>& csvStringColumns( csvKind );
+
+/**
+ * Writes the paragraph, sentence and word .csv output of a document one
+ * paragraph at a time, for documents that are analysed in bounded memory.
+ * The rows go to the .csv files of the document, to the corpus output, or
+ * to columnar files as a row group per paragraph. Rows for the corpus are
+ * spooled, and only added to it by commit() when the document is done.
+ */
+class paragraphWriter {
+public:
+  paragraphWriter( const std::string&, const std::vector<csvKind>&,
+                   CorpusWriter * );
+  paragraphWriter( const std::string&, const std::vector<csvKind>&,
+                   ColumnarWriter *const * );
+  ~paragraphWriter();
+  void add( const parStats* );
+  void commit();
+private:
+  paragraphWriter( const paragraphWriter& ) = delete;
+  paragraphWriter& operator=( const paragraphWriter& ) = delete;
+  std::string name;
+  std::vector<csvKind> kinds;
+  CorpusWriter *corpus;
+  bool headers[WORD_CSV + 1];
+  csvFile files[WORD_CSV + 1];
+  ColumnarWriter *columns[WORD_CSV + 1];
+  std::unique_ptr<ColumnarWriter> own_columns[WORD_CSV + 1];
+  std::unique_ptr<spoolFile> spools[WORD_CSV + 1];
+};
+
 struct docStats : public structStats {
-  explicit docStats( const std::string&, folia::Document* );
+  docStats( const std::string&, folia::Document*, StatsArena& );
   bool isDocument() const override { return true; };
   void toCSV( const std::string&, csvKind ) const;
+  void toCSV( csvRow&, const std::string&, csvKind ) const;
+  std::string csvText( const std::string&, csvKind ) const;
+  void toColumns( ColumnarWriter&, const std::string&, csvKind ) const;
   double rarity( int level ) const override;
   void addMetrics() const override;
   int word_overlapCnt() const override { return doc_word_overlapCnt; };
   int lemma_overlapCnt() const override { return doc_lemma_overlapCnt; };
-  void calculate_doc_overlap();
+  void add_doc_overlap( const word_range&, OverlapWindow&, OverlapWindow& );
+  void memoryReport( std::ostream&, const std::string&, const StatsArena& ) const;
   int doc_word_overlapCnt;
   int doc_lemma_overlapCnt;
+  int parCnt;
   double rarity_index;
+  word_index doc_words;
 };
 
-template <class T, typename F>
-void resolveMultiWord( const std::vector<basicStats *> &sv, const std::map<std::string, T> &m, const size_t &max_length, F &&assign ) {
-
-  for ( size_t i = 0; i < sv.size() - 1; ++i ) {
-    std::string startword = sv[i]->ltext();
-    std::string multiword = startword;
 
-    for ( size_t j = 1; i + j < sv.size() && j < max_length; ++j ) {
-      // Attach the next word to the expression
-      multiword += " " + sv[i + j]->ltext();
+template <class T, typename F>
+void resolveMultiWord( const std::vector<basicStats *> &sv, const PhraseMatches &phrases, Phrase::Lexicon lexicon, const size_t &max_length, F &&assign ) {
 
-      // Look for the expression in the list
-      auto sit = m.find( multiword );
-      // If found, update the counts, if not, continue
-      if ( sit != m.end() ) {
-        for ( size_t k = i; k <= i + j; k++ ) {
-          auto word = dynamic_cast<wordStats *>( sv[k] );
-          assign( word, sit->second );
-        }
-        // Break and skip to the first word after this expression
-        i += j;
-        break;
+  for ( size_t i = 0; i + 1 < sv.size(); ++i ) {
+    // Look for the shortest expression starting here
+    size_t length;
+    int value = phrases.shortest( i, max_length, lexicon, length );
+    // If found, update the counts, if not, continue
+    if ( value >= 0 ) {
+      for ( size_t k = i; k < i + length; k++ ) {
+        auto word = dynamic_cast<wordStats *>( sv[k] );
+        assign( word, static_cast<T>( value ) );
       }
+      // Skip to the first word after this expression
+      i += length - 1;
     }
   }
 }
@@ -2,9 +2,12 @@
 #define UTILS_H
 
 #include <map>
+#include <array>
 #include <cmath>
 #include <set>
 #include <string>
+#include <cstdio>
+#include <type_traits>
 #include <fstream>
 #include <iostream>
 #include "ticcutils/StringOps.h"
@@ -13,12 +16,46 @@
 static std::string suffixesArray[] = { "e", "en", "s" };
 
 void addOneMetric( folia::Document*, folia::FoliaElement*, const std::string&, const std::string& );
-void argument_overlap( const std::string&, const std::vector<std::string>&, int& );
+inline void addOneMetric( folia::Document *doc, folia::FoliaElement *parent,
+                          const std::string& cls, const char *val ) {
+  addOneMetric( doc, parent, cls, std::string( val ) );
+}
+
+std::string metricValue( double );
+
+/**
+ * The text of a metric value, the same as TiCC::toString() gives, but
+ * without a stringstream for numbers
+ */
+template <class T, bool = std::is_arithmetic<T>::value
+                          && !std::is_same<T, char>::value>
+struct metric_text {
+  static std::string get( const T& val ) { return TiCC::toString( val ); };
+};
+
+template <class T>
+struct metric_text<T, true> {
+  static std::string get( T val ) {
+    if ( std::is_floating_point<T>::value )
+      return metricValue( double( val ) );
+    else
+      return std::to_string( val );
+  };
+};
+
+/**
+ * Adds a Metric with a value of any type, converted by metric_text
+ */
+template <class T>
+void addOneMetric( folia::Document *doc, folia::FoliaElement *parent,
+                   const std::string& cls, const T& val ) {
+  addOneMetric( doc, parent, cls, metric_text<T>::get( val ) );
+}
+
 std::istream& safe_getline( std::istream&, std::string& );
 void updateCounter( std::map<std::string, int>&, std::map<std::string, int>);
 std::string toStringCounter( std::map<std::string, int>);
 std::string toMString( double d );
-std::string escape_quotes(const std::string &before);
 
 /**
  * Search a maps for the passed word and also tries searching it
@@ -62,6 +99,10 @@ template<class T> int at( const std::map<T,int>& m, const T key ) {
     return 0;
 }
 
+template<class T, size_t N> int at( const std::array<int,N>& a, const T key ) {
+  return a[key];
+}
+
 template<class M> void aggregate( M& out, const M& in ){
   typename M::const_iterator ii = in.begin();
   while ( ii != in.end() ){
@@ -76,6 +117,13 @@ template<class M> void aggregate( M& out, const M& in ){
   }
 }
 
+template<class T, size_t N> void aggregate( std::array<T,N>& out,
+                                            const std::array<T,N>& in ){
+  for ( size_t i = 0; i < N; ++i ){
+    out[i] += in[i];
+  }
+}
+
 struct proportion {
   proportion( double d1, double d2 ) {
     if ( d2 == 0 || std::isnan(d1) || std::isnan(d2) )
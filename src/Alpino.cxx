@@ -26,44 +26,74 @@
 using namespace std;
 
 
-string MMtoString( const multimap<DD_type, int>& mm, DD_type t ){
-  size_t len = mm.count(t);
-  if ( len > 0 ){
-    int result = 0;
-    for( multimap<DD_type, int>::const_iterator pos = mm.lower_bound(t);
-   pos != mm.upper_bound(t);
-   ++pos ){
-      result += pos->second;
-    }
-    return TiCC::toString( result/double(len) );
+DistanceStats::DistanceStats(){
+  accumulator zero = { 0, 0, 0 };
+  acc.fill( zero );
+}
+
+void DistanceStats::add( DD_type t, int dist ){
+  accumulator& a = acc[t];
+  ++a.count;
+  a.sum += dist;
+  if ( dist > a.max )
+    a.max = dist;
+}
+
+void DistanceStats::merge( const DistanceStats& in ){
+  for ( int t=0; t < DD_type_count; ++t ){
+    acc[t].count += in.acc[t].count;
+    acc[t].sum += in.acc[t].sum;
+    if ( in.acc[t].max > acc[t].max )
+      acc[t].max = in.acc[t].max;
   }
+}
+
+bool DistanceStats::empty() const {
+  for ( int t=0; t < DD_type_count; ++t ){
+    if ( acc[t].count > 0 )
+      return false;
+  }
+  return true;
+}
+
+/**
+ * The mean distance of one type, for output
+ * @param t the DD_type
+ * @return the mean, or "NA" when there are no distances of this type
+ */
+string DistanceStats::mean( DD_type t ) const {
+  if ( acc[t].count > 0 )
+    return TiCC::toString( acc[t].sum/double(acc[t].count) );
   else
     return "NA";
 }
 
-string MMtoString( const multimap<DD_type, int>& mm ){
-  size_t len = mm.size();
-  if ( len > 0 ){
-    int result = 0;
-    for( multimap<DD_type, int>::const_iterator pos = mm.begin();
-   pos != mm.end();
-   ++pos ){
-      if ( !std::isnan(pos->second) )
-  result += pos->second;
-    }
-    cerr << "MM to string " << result << "/" << len << endl;
-    return TiCC::toString( result/double(len) );
+/**
+ * The mean distance over all types, NAN when there are no distances
+ */
+double DistanceStats::mean() const {
+  int count = 0;
+  double sum = 0;
+  for ( int t=0; t < DD_type_count; ++t ){
+    count += acc[t].count;
+    sum += acc[t].sum;
   }
+  if ( count > 0 )
+    return sum / count;
   else
-    return "NA";
+    return NAN;
 }
 
-void aggregate( multimap<DD_type,int>& out, const multimap<DD_type,int>& in ) {
-  multimap<DD_type,int>::const_iterator ii = in.begin();
-  while ( ii != in.end() ){
-    out.insert( make_pair(ii->first, ii->second ) );
-    ++ii;
+/**
+ * The largest distance over all types, 0 when there are no distances
+ */
+int DistanceStats::highest() const {
+  int result = 0;
+  for ( int t=0; t < DD_type_count; ++t ){
+    if ( acc[t].max > result )
+      result = acc[t].max;
   }
+  return result;
 }
 
 xmlNode *getAlpNodeWord( xmlDoc *doc, const folia::Word *w ){
@@ -271,7 +301,7 @@ int get_begin( const xmlNode *n ){
   return TiCC::stringTo<int>( bpos );
 }
 
-void store_result( multimap<DD_type,int>& result, DD_type type,
+void store_result( DistanceStats& result, DD_type type,
        const xmlNode *n1, const xmlNode*n2,
        const set<size_t>& puncts ){
   // store distances per type. Compensate for skipped punctuation
@@ -287,14 +317,14 @@ void store_result( multimap<DD_type,int>& result, DD_type type,
     }
   //  cerr << "store " << type << "(" << pos1 << "," << pos2 << ")=" << dist << endl;
   if ( dist >= 0 ){
-    result.insert( make_pair( type, dist ) );
+    result.add( type, dist );
   }
 }
 
-multimap<DD_type, int> getDependencyDist( const xmlNode *head_node,
-            const set<size_t>& puncts ){
+DistanceStats getDependencyDist( const xmlNode *head_node,
+                                 const set<size_t>& puncts ){
   // walk down the Alpino tree and gather all types of distances
-  multimap<DD_type,int> result;
+  DistanceStats result;
   if ( head_node ){
     folia::KWargs atts = folia::getAttributes( head_node );
     string head_rel = atts["rel"];
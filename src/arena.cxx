@@ -0,0 +1,38 @@
+#include <algorithm>
+#include <cstdint>
+#include "tscan/arena.h"
+
+using namespace std;
+
+StatsArena::StatsArena( size_t size ):
+  block_size( size ), reserved( 0 ), current( 0 ), left( 0 ) {
+}
+
+StatsArena::~StatsArena() {
+  for ( auto it = cleanups.rbegin(); it != cleanups.rend(); ++it ) {
+    it->second( it->first );
+  }
+  for ( auto block : blocks ) {
+    delete [] block;
+  }
+}
+
+/**
+ * Reserve room for an object. A new block is started when the current
+ * one is full, at least large enough for the object.
+ */
+void *StatsArena::allocate( size_t size, size_t align ) {
+  size_t pad = ( align - reinterpret_cast<uintptr_t>( current ) % align ) % align;
+  if ( current == 0 || pad + size > left ) {
+    size_t len = max( block_size, size + align );
+    current = new char[len];
+    blocks.push_back( current );
+    reserved += len;
+    left = len;
+    pad = ( align - reinterpret_cast<uintptr_t>( current ) % align ) % align;
+  }
+  void *result = current + pad;
+  current += pad + size;
+  left -= pad + size;
+  return result;
+}
@@ -0,0 +1,379 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <chrono>
+#include <algorithm>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include "tscan/async.h"
+
+using namespace std;
+
+/// @brief a resolved address of a server
+struct AsyncClient::Address {
+  int family;
+  int socktype;
+  int protocol;
+  struct sockaddr_storage addr;
+  socklen_t addrlen;
+};
+
+struct AsyncClient::Request {
+  enum State { CONNECTING, SENDING, RECEIVING };
+  Request( const string& h, const string& p, const string& m,
+           Until u, const string& mark ):
+    host( h ), port( p ), out( m ), until( u ), marker( mark ),
+    written( 0 ), fd( -1 ), state( CONNECTING ) {};
+  string host;
+  string port;
+  vector<Address> addresses;
+  chrono::steady_clock::time_point deadline;
+  string out;
+  Until until;
+  string marker;
+  size_t written;
+  string in;
+  int fd;
+  State state;
+  promise<string> reply;
+};
+
+static void fail( promise<string>& reply, const string& message ) {
+  reply.set_exception( make_exception_ptr( runtime_error( message ) ) );
+}
+
+AsyncClient::AsyncClient( size_t max, int secs ):
+  max_in_flight( max > 0 ? max : 1 ),
+  timeout( secs > 0 ? secs : 0 ),
+  stopping( false ) {
+  if ( pipe( wake_pipe ) != 0 ) {
+    throw runtime_error( string( "AsyncClient: unable to create pipe: " )
+                         + strerror( errno ) );
+  }
+  fcntl( wake_pipe[0], F_SETFL, O_NONBLOCK );
+  fcntl( wake_pipe[1], F_SETFL, O_NONBLOCK );
+  loop = thread( &AsyncClient::run, this );
+}
+
+AsyncClient::~AsyncClient() {
+  {
+    lock_guard<mutex> lock( mtx );
+    stopping = true;
+  }
+  wake();
+  loop.join();
+  close( wake_pipe[0] );
+  close( wake_pipe[1] );
+}
+
+void AsyncClient::setMaxInFlight( size_t max ) {
+  lock_guard<mutex> lock( mtx );
+  max_in_flight = ( max > 0 ? max : 1 );
+}
+
+void AsyncClient::setTimeout( int secs ) {
+  lock_guard<mutex> lock( mtx );
+  timeout = ( secs > 0 ? secs : 0 );
+}
+
+/**
+ * Look up the addresses of a server. They are remembered, so the name
+ * server is asked only once per host and port.
+ * @return false when the host is unknown
+ */
+bool AsyncClient::resolve( const string& host, const string& port,
+                           vector<Address>& result, string& message ) {
+  const string key = host + ":" + port;
+  lock_guard<mutex> lock( resolve_mtx );
+  auto it = addresses.find( key );
+  if ( it != addresses.end() ) {
+    result = it->second;
+    return true;
+  }
+  struct addrinfo hints;
+  memset( &hints, 0, sizeof( hints ) );
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *res = 0;
+  int err = getaddrinfo( host.c_str(), port.c_str(), &hints, &res );
+  if ( err != 0 ) {
+    message = key + ": " + gai_strerror( err );
+    return false;
+  }
+  result.clear();
+  for ( struct addrinfo *ai = res; ai != 0; ai = ai->ai_next ) {
+    Address a;
+    a.family = ai->ai_family;
+    a.socktype = ai->ai_socktype;
+    a.protocol = ai->ai_protocol;
+    memcpy( &a.addr, ai->ai_addr, ai->ai_addrlen );
+    a.addrlen = ai->ai_addrlen;
+    result.push_back( a );
+  }
+  freeaddrinfo( res );
+  addresses[key] = result;
+  return true;
+}
+
+/**
+ * Queue a request. The returned future gets the reply, or an exception
+ * when the server could not be reached.
+ * @param host    the server host
+ * @param port    the server port
+ * @param message the text to send
+ * @param until   how to recognize the end of the reply
+ * @param marker  the final line, for MARKER_LINE
+ */
+shared_future<string> AsyncClient::request( const string& host,
+                                            const string& port,
+                                            const string& message,
+                                            Until until,
+                                            const string& marker ) {
+  Request *r = new Request( host, port, message, until, marker );
+  shared_future<string> result = r->reply.get_future().share();
+  string reason;
+  if ( !resolve( host, port, r->addresses, reason ) ) {
+    fail( r->reply, reason );
+    delete r;
+    return result;
+  }
+  {
+    lock_guard<mutex> lock( mtx );
+    queued.push_back( r );
+  }
+  wake();
+  return result;
+}
+
+void AsyncClient::wake() {
+  char c = 0;
+  ssize_t res = write( wake_pipe[1], &c, 1 );
+  (void)res; // a full pipe wakes up the loop anyway
+}
+
+/**
+ * Start a non-blocking connect for the request
+ * @return false when no connection is possible
+ */
+bool AsyncClient::open( Request *r ) {
+  string reason = "no address";
+  for ( const auto& a : r->addresses ) {
+    int fd = socket( a.family, a.socktype, a.protocol );
+    if ( fd < 0 ) {
+      reason = strerror( errno );
+      continue;
+    }
+    fcntl( fd, F_SETFL, fcntl( fd, F_GETFL, 0 ) | O_NONBLOCK );
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt( fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof( on ) );
+#endif
+    if ( connect( fd, reinterpret_cast<const struct sockaddr *>( &a.addr ),
+                  a.addrlen ) == 0
+         || errno == EINPROGRESS ) {
+      r->fd = fd;
+      break;
+    }
+    reason = strerror( errno );
+    close( fd );
+  }
+  if ( r->fd < 0 ) {
+    fail( r->reply, r->host + ":" + r->port + ": " + reason );
+    return false;
+  }
+  r->deadline = chrono::steady_clock::now() + chrono::seconds( timeout );
+  return true;
+}
+
+/**
+ * Check whether the reply is complete. When it is, 'in' is trimmed down
+ * to the reply proper.
+ */
+static bool complete( string& in, AsyncClient::Until until,
+                      const string& marker ) {
+  if ( until == AsyncClient::FIRST_LINE ) {
+    size_t pos = in.find( '\n' );
+    if ( pos == string::npos ) {
+      return false;
+    }
+    in.resize( pos );
+    return true;
+  }
+  if ( until == AsyncClient::MARKER_LINE ) {
+    size_t start = 0;
+    size_t pos;
+    while ( ( pos = in.find( '\n', start ) ) != string::npos ) {
+      if ( in.compare( start, pos - start, marker ) == 0 ) {
+        in.resize( start );
+        return true;
+      }
+      start = pos + 1;
+    }
+  }
+  return false;
+}
+
+/**
+ * Handle a poll event for a request
+ * @return true when the request is finished (either way)
+ */
+bool AsyncClient::progress( Request *r, short revents ) {
+  if ( r->state == Request::CONNECTING ) {
+    int err = 0;
+    socklen_t len = sizeof( err );
+    getsockopt( r->fd, SOL_SOCKET, SO_ERROR, &err, &len );
+    if ( err != 0 ) {
+      fail( r->reply, r->host + ":" + r->port + ": " + strerror( err ) );
+      return true;
+    }
+    r->state = Request::SENDING;
+  }
+  if ( r->state == Request::SENDING ) {
+    if ( revents & ( POLLERR | POLLHUP ) ) {
+      fail( r->reply, r->host + ":" + r->port + ": connection lost" );
+      return true;
+    }
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    ssize_t n = send( r->fd, r->out.data() + r->written,
+                      r->out.size() - r->written, flags );
+    if ( n < 0 ) {
+      if ( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ) {
+        return false;
+      }
+      fail( r->reply, r->host + ":" + r->port + ": " + strerror( errno ) );
+      return true;
+    }
+    r->written += n;
+    if ( r->written == r->out.size() ) {
+      r->out.clear();
+      r->state = Request::RECEIVING;
+    }
+    return false;
+  }
+  char buf[16384];
+  ssize_t n = recv( r->fd, buf, sizeof( buf ), 0 );
+  if ( n < 0 ) {
+    if ( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ) {
+      return false;
+    }
+    fail( r->reply, r->host + ":" + r->port + ": " + strerror( errno ) );
+    return true;
+  }
+  if ( n > 0 ) {
+    r->in.append( buf, n );
+    if ( complete( r->in, r->until, r->marker ) ) {
+      r->reply.set_value( r->in );
+      return true;
+    }
+    return false;
+  }
+  // the server closed the connection. Like the line based reads did, we
+  // make sure the last line is terminated.
+  if ( r->until == FIRST_LINE ) {
+    size_t pos = r->in.find( '\n' );
+    if ( pos != string::npos ) {
+      r->in.resize( pos );
+    }
+  }
+  else if ( !r->in.empty() && r->in[r->in.size() - 1] != '\n' ) {
+    r->in += "\n";
+  }
+  r->reply.set_value( r->in );
+  return true;
+}
+
+void AsyncClient::run() {
+  vector<struct pollfd> fds;
+  while ( true ) {
+    int wait = -1;
+    int limit;
+    {
+      lock_guard<mutex> lock( mtx );
+      while ( !queued.empty() && active.size() < max_in_flight ) {
+        Request *r = queued.front();
+        queued.pop_front();
+        if ( open( r ) ) {
+          active.push_back( r );
+        }
+        else {
+          delete r;
+        }
+      }
+      if ( stopping && active.empty() && queued.empty() ) {
+        break;
+      }
+      limit = timeout;
+      if ( limit > 0 && !active.empty() ) {
+        // wake up in time for the first deadline
+        auto first = active[0]->deadline;
+        for ( const auto& r : active ) {
+          first = min( first, r->deadline );
+        }
+        auto left = chrono::duration_cast<chrono::milliseconds>(
+          first - chrono::steady_clock::now() ).count();
+        wait = ( left < 0 ? 0 : int( left ) + 1 );
+      }
+    }
+    fds.resize( active.size() + 1 );
+    fds[0].fd = wake_pipe[0];
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    for ( size_t i = 0; i < active.size(); ++i ) {
+      fds[i + 1].fd = active[i]->fd;
+      fds[i + 1].events =
+        ( active[i]->state == Request::RECEIVING ? POLLIN : POLLOUT );
+      fds[i + 1].revents = 0;
+    }
+    if ( poll( &fds[0], fds.size(), wait ) < 0 ) {
+      if ( errno == EINTR ) {
+        continue;
+      }
+      throw runtime_error( string( "AsyncClient: poll failed: " )
+                           + strerror( errno ) );
+    }
+    if ( fds[0].revents & POLLIN ) {
+      char buf[256];
+      while ( read( wake_pipe[0], buf, sizeof( buf ) ) > 0 ) {
+      }
+    }
+    const auto now = chrono::steady_clock::now();
+    size_t kept = 0;
+    for ( size_t i = 0; i < active.size(); ++i ) {
+      Request *r = active[i];
+      if ( fds[i + 1].revents != 0 && progress( r, fds[i + 1].revents ) ) {
+        close( r->fd );
+        delete r;
+      }
+      else if ( limit > 0 && now >= r->deadline ) {
+        fail( r->reply, r->host + ":" + r->port + ": no reply within "
+              + to_string( limit ) + " seconds" );
+        close( r->fd );
+        delete r;
+      }
+      else {
+        active[kept++] = r;
+      }
+    }
+    active.resize( kept );
+  }
+}
+
+bool getReply( const shared_future<string>& future, string& reply,
+               string& message ) {
+  try {
+    reply = future.get();
+    return true;
+  }
+  catch ( const exception& e ) {
+    message = e.what();
+    return false;
+  }
+}
@@ -0,0 +1,213 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "tscan/columnar.h"
+#include "tscan/spool.h"
+
+using namespace std;
+
+enum column_type { DOUBLE_COLUMN = 1, STRING_COLUMN = 2 };
+
+/// @brief the dictionary index of NA in a string column
+const uint32_t na_index = 0xFFFFFFFF;
+
+/**
+ * @param strings the names of the columns that hold strings; it must
+ *                outlive the table
+ */
+ColumnarTable::ColumnarTable( const vector<string>& strings ):
+  string_columns( strings ), row_count( 0 ) {
+}
+
+/**
+ * Set up the columns from the header of the table. A table that gets
+ * several headers, e.g. one per paragraph, keeps the first.
+ */
+void ColumnarTable::header( const vector<string>& names ) {
+  if ( !columns.empty() ) {
+    return;
+  }
+  columns.resize( names.size() );
+  for ( size_t c = 0; c < names.size(); ++c ) {
+    columns[c].name = names[c];
+    columns[c].is_string = find( string_columns.begin(), string_columns.end(),
+                                 names[c] ) != string_columns.end();
+  }
+}
+
+void ColumnarTable::row( const vector<csvField>& fields ) {
+  if ( columns.empty() ) {
+    cerr << "columnar output: a row without a header is skipped" << endl;
+    return;
+  }
+  const csvField na;
+  for ( size_t c = 0; c < columns.size(); ++c ) {
+    // rows that are cut short (no parse) get NA in their other columns
+    const csvField& f = ( c < fields.size() ) ? fields[c] : na;
+    column& col = columns[c];
+    if ( col.is_string ) {
+      if ( f.kind == csvField::NA ) {
+        col.indexes.push_back( na_index );
+        continue;
+      }
+      string text = f.text;
+      if ( f.kind == csvField::NUMBER ) {
+        char buf[32];
+        snprintf( buf, sizeof( buf ), "%.17g", f.number );
+        text = buf;
+      }
+      auto it = col.dictionary.insert( make_pair( text, col.entries.size() ) );
+      if ( it.second ) {
+        col.entries.push_back( &it.first->first );
+      }
+      col.indexes.push_back( it.first->second );
+    }
+    else if ( f.kind == csvField::NUMBER ) {
+      col.numbers.push_back( f.number );
+    }
+    else if ( f.kind == csvField::NA ) {
+      col.numbers.push_back( NAN );
+    }
+    else {
+      // a number in the text of the format, like the "1" of a flag
+      char *end;
+      double d = strtod( f.text.c_str(), &end );
+      if ( f.text.empty() || *end != 0 ) {
+        cerr << "columnar output: '" << f.text << "' in number column "
+             << col.name << " is stored as NA" << endl;
+        d = NAN;
+      }
+      col.numbers.push_back( d );
+    }
+  }
+  ++row_count;
+}
+
+template <class T>
+static void put( ostream& os, T val ) {
+  // the supported platforms are little endian already
+  os.write( reinterpret_cast<const char *>( &val ), sizeof( T ) );
+}
+
+static void put_string( ostream& os, const string& s ) {
+  put<uint32_t>( os, s.size() );
+  os.write( s.data(), s.size() );
+}
+
+ColumnarWriter::ColumnarWriter( const string& name ):
+  filename( name ), file( name.c_str(), ios::binary ), has_schema( false ) {
+  file.write( "TSCOL02\n", 8 );
+}
+
+ColumnarWriter::~ColumnarWriter() {
+  if ( !has_schema ) {
+    // no rows at all: an empty schema
+    put<uint32_t>( file, 0 );
+  }
+}
+
+/**
+ * Write the schema from the first table with columns, or check that the
+ * table has the columns of the schema. The caller holds the lock.
+ */
+bool ColumnarWriter::schema( const ColumnarTable& table ) {
+  if ( !has_schema ) {
+    put<uint32_t>( file, table.columns.size() );
+    for ( const auto& col : table.columns ) {
+      put_string( file, col.name );
+      put<uint8_t>( file, col.is_string ? STRING_COLUMN : DOUBLE_COLUMN );
+      names.push_back( col.name );
+    }
+    has_schema = true;
+    return true;
+  }
+  bool same = table.columns.size() == names.size();
+  for ( size_t c = 0; same && c < names.size(); ++c ) {
+    same = table.columns[c].name == names[c];
+  }
+  if ( !same ) {
+    cerr << "columnar output: rows with other columns are not added to "
+         << filename << endl;
+  }
+  return same;
+}
+
+/**
+ * Write the rows of a table as a row group
+ */
+void ColumnarWriter::group( ostream& os, const ColumnarTable& table ) {
+  put<uint64_t>( os, table.rows() );
+  for ( const auto& col : table.columns ) {
+    if ( col.is_string ) {
+      put<uint32_t>( os, col.entries.size() );
+      for ( const auto e : col.entries ) {
+        put_string( os, *e );
+      }
+      os.write( reinterpret_cast<const char *>( col.indexes.data() ),
+                col.indexes.size() * sizeof( uint32_t ) );
+    }
+    else {
+      os.write( reinterpret_cast<const char *>( col.numbers.data() ),
+                col.numbers.size() * sizeof( double ) );
+    }
+  }
+}
+
+/**
+ * Add the rows of a table as a row group, and flush it. The first table
+ * with columns sets the schema of the file.
+ */
+void ColumnarWriter::add( const ColumnarTable& table ) {
+  if ( table.rows() == 0 ) {
+    return;
+  }
+  lock_guard<mutex> lock( mtx );
+  if ( schema( table ) ) {
+    group( file, table );
+    file.flush();
+  }
+}
+
+/**
+ * Add the rows of a table as a row group to a spool instead, to add them
+ * later with the rest of the document. The schema is written at once.
+ */
+void ColumnarWriter::spool( const ColumnarTable& table, spoolFile& out ) {
+  if ( table.rows() == 0 ) {
+    return;
+  }
+  {
+    lock_guard<mutex> lock( mtx );
+    if ( !schema( table ) ) {
+      return;
+    }
+    file.flush();
+  }
+  ostringstream os;
+  group( os, table );
+  out.write( os.str() );
+}
+
+/**
+ * Add the spooled row groups of a document, and flush them. Nothing is
+ * added when they could not be spooled completely.
+ */
+void ColumnarWriter::add( spoolFile& groups ) {
+  if ( !groups.good() ) {
+    cerr << "spooling the statistics of a document FAILED! It is not "
+         << "added to " << filename << endl;
+    return;
+  }
+  if ( groups.size() == 0 ) {
+    return;
+  }
+  groups.rewind();
+  lock_guard<mutex> lock( mtx );
+  if ( !groups.copy( file ) ) {
+    cerr << "adding spooled statistics to " << filename << " FAILED!" << endl;
+  }
+  file.flush();
+}
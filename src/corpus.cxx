@@ -0,0 +1,150 @@
+#include <cstdio>
+#include <iostream>
+#include "tscan/corpus.h"
+#include "tscan/spool.h"
+
+using namespace std;
+
+/**
+ * @param prefix     the start of the file names
+ * @param names      the name of each table, e.g. "words"
+ * @param shard_size the maximum size of a file in bytes, or 0
+ */
+CorpusWriter::CorpusWriter( const string& p, const vector<string>& names,
+                            size_t size ):
+  prefix( p ), shard_size( size ), tables( names.size() ) {
+  for ( size_t i = 0; i < names.size(); ++i ) {
+    tables[i].name = names[i];
+    tables[i].shard = 0;
+    tables[i].written = 0;
+  }
+}
+
+CorpusWriter::~CorpusWriter() {
+  for ( auto& t : tables ) {
+    if ( t.file.is_open() ) {
+      t.file.close();
+      cerr << "stored " << t.name << " statistics of the corpus in " << prefix
+           << "." << t.name << ( shard_size > 0 ? ".*" : "" ) << ".csv" << endl;
+    }
+  }
+}
+
+/**
+ * Start the next file of a table
+ */
+void CorpusWriter::open( table& t ) {
+  if ( t.file.is_open() ) {
+    t.file.close();
+  }
+  ++t.shard;
+  string fname = prefix + "." + t.name;
+  if ( shard_size > 0 ) {
+    char num[16];
+    snprintf( num, sizeof( num ), ".%04zu", t.shard );
+    fname += num;
+  }
+  fname += ".csv";
+  t.file.open( fname.c_str() );
+  if ( !t.file ) {
+    cerr << "storing " << t.name << " statistics in " << fname << " FAILED!"
+         << endl;
+  }
+  t.written = 0;
+}
+
+/**
+ * Make room for the rows of a document in a table, with a header line at
+ * the start of each file
+ * @param t      the table
+ * @param header the header line of the document
+ * @param rows   the size of the rows; a next shard starts when they do
+ *               not fit in the current one
+ */
+void CorpusWriter::prepare( table& t, const string& header, size_t rows ) {
+  if ( t.header.empty() ) {
+    t.header = header;
+  }
+  if ( !t.file.is_open()
+       || ( shard_size > 0 && t.written > 0
+            && t.written + rows > shard_size ) ) {
+    open( t );
+  }
+  if ( t.written == 0 ) {
+    t.file << t.header;
+    t.written += t.header.size();
+  }
+}
+
+/**
+ * Append the rows of a document to a table
+ * @param t    the table
+ * @param text the .csv text, starting with its header line
+ */
+void CorpusWriter::append( table& t, const string& text ) {
+  if ( text.empty() ) {
+    return;
+  }
+  size_t eol = text.find( '\n' );
+  size_t start = ( eol == string::npos ) ? text.size() : eol + 1;
+  size_t rows = text.size() - start;
+  prepare( t, text.substr( 0, start ), rows );
+  t.file.write( text.data() + start, rows );
+  t.file.flush();
+  t.written += rows;
+}
+
+/**
+ * Append the spooled rows of a document to a table
+ * @param t     the table
+ * @param spool the .csv text, starting with its header line
+ */
+void CorpusWriter::append( table& t, spoolFile& spool ) {
+  if ( spool.size() == 0 ) {
+    return;
+  }
+  spool.rewind();
+  string header;
+  spool.getline( header );
+  size_t rows = spool.size() - header.size();
+  prepare( t, header, rows );
+  if ( !spool.copy( t.file ) ) {
+    cerr << "adding spooled " << t.name << " statistics to the corpus FAILED!"
+         << endl;
+  }
+  t.file.flush();
+  t.written += rows;
+}
+
+/**
+ * Add the tables of one document
+ * @param texts the .csv text of each table, empty when there is none
+ */
+void CorpusWriter::add( const vector<string>& texts ) {
+  lock_guard<mutex> lock( mtx );
+  for ( size_t i = 0; i < texts.size() && i < tables.size(); ++i ) {
+    append( tables[i], texts[i] );
+  }
+}
+
+/**
+ * Add the tables of one document that was written part by part. Nothing
+ * is added when one of them could not be spooled completely.
+ * @param spools the spooled .csv text of each table, or 0 when there is
+ *               none
+ */
+void CorpusWriter::add( const vector<spoolFile*>& spools ) {
+  for ( const auto spool : spools ) {
+    if ( spool && !spool->good() ) {
+      cerr << "spooling the statistics of a document FAILED! It is not "
+           << "added to the corpus" << endl;
+      return;
+    }
+  }
+  lock_guard<mutex> lock( mtx );
+  for ( size_t i = 0; i < spools.size() && i < tables.size(); ++i ) {
+    if ( spools[i] ) {
+      append( tables[i], *spools[i] );
+    }
+  }
+}
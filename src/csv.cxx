@@ -0,0 +1,188 @@
+#include <cstdio>
+#include <locale>
+#include <algorithm>
+#include "tscan/csv.h"
+#include "tscan/utils.h"
+
+using namespace std;
+
+/// @brief the size of the buffer of a .csv output file
+const size_t csv_buffer_size = 1024 * 1024;
+
+/**
+ * A num_put facet that writes doubles with snprintf, the way the standard
+ * one does for the "C" numeric conventions
+ */
+class csv_num_put : public num_put<char> {
+public:
+  explicit csv_num_put( size_t refs = 0 ): num_put<char>( refs ) {};
+protected:
+  iter_type do_put( iter_type out, ios_base& str, char_type fill,
+                    double v ) const override {
+    const ios_base::fmtflags flags = str.flags();
+    const ios_base::fmtflags field = flags & ios_base::floatfield;
+    if ( str.width() != 0 || str.precision() < 0
+         || ( flags & ( ios_base::showpos | ios_base::uppercase ) )
+         || field == ( ios_base::fixed | ios_base::scientific ) ) {
+      return num_put<char>::do_put( out, str, fill, v );
+    }
+    const char *format;
+    if ( field == ios_base::fixed )
+      format = ( flags & ios_base::showpoint ) ? "%#.*f" : "%.*f";
+    else if ( field == ios_base::scientific )
+      format = ( flags & ios_base::showpoint ) ? "%#.*e" : "%.*e";
+    else
+      format = ( flags & ios_base::showpoint ) ? "%#.*g" : "%.*g";
+    char buf[64];
+    int len = snprintf( buf, sizeof( buf ), format,
+                        static_cast<int>( str.precision() ), v );
+    if ( len < 0 || len >= static_cast<int>( sizeof( buf ) ) ) {
+      // a huge fixed value
+      return num_put<char>::do_put( out, str, fill, v );
+    }
+    return copy( buf, buf + len, out );
+  }
+};
+
+void csvStream( ios& s ) {
+  const locale& loc = s.getloc();
+  const numpunct<char>& punct = use_facet<numpunct<char>>( loc );
+  if ( punct.decimal_point() == '.' && punct.grouping().empty() ) {
+    s.imbue( locale( loc, new csv_num_put() ) );
+  }
+}
+
+csvFile::csvFile(): buffer( csv_buffer_size ) {
+  rdbuf()->pubsetbuf( buffer.data(), buffer.size() );
+  csvStream( *this );
+}
+
+csvFile::csvFile( const string& name ): csvFile() {
+  open( name.c_str() );
+}
+
+csvFile::~csvFile() {
+  // flush before the buffer goes
+  close();
+}
+
+ostream& operator<<( ostream& os, const csvQuoted& q ) {
+  os << '"';
+  size_t start = 0;
+  size_t pos;
+  while ( ( pos = q.text.find( '"', start ) ) != string::npos ) {
+    os.write( q.text.data() + start, pos + 1 - start );
+    os << '"';
+    start = pos + 1;
+  }
+  os.write( q.text.data() + start, q.text.size() - start );
+  os << '"';
+  return os;
+}
+
+ostream& operator<<( ostream& os, const csvNumber& n ) {
+  return os << toMString( n.value );
+}
+
+csvRow& csvRow::operator<<( const csvNumber& n ) {
+  if ( os ) *os << n; else number( n.value );
+  return *this;
+}
+
+csvRow& csvRow::operator<<( const proportion& p ) {
+  if ( os ) *os << p; else number( p.p );
+  return *this;
+}
+
+csvRow& csvRow::operator<<( const density& d ) {
+  if ( os ) *os << d; else number( d.d );
+  return *this;
+}
+
+/**
+ * Text of the format: it separates the fields and rows, and quotes them
+ */
+void csvRow::format( const char *s ) {
+  for ( ; *s; ++s ) {
+    format( *s );
+  }
+}
+
+void csvRow::format( char c ) {
+  if ( c == ',' ) {
+    endField();
+  }
+  else if ( c == '\n' ) {
+    endRow();
+  }
+  else if ( c != '"' ) {
+    field.text += c;
+    started = true;
+  }
+}
+
+/**
+ * Text of the data, kept as it is
+ */
+void csvRow::data( const string& s ) {
+  if ( in_header ) {
+    // column names, like the intro of a header
+    format( s.c_str() );
+    return;
+  }
+  field.text += s;
+  field.literal = false;
+  started = true;
+}
+
+void csvRow::number( double d ) {
+  if ( !started ) {
+    field.kind = csvField::NUMBER;
+    field.number = d;
+    started = true;
+  }
+  else {
+    // part of a text
+    char buf[32];
+    snprintf( buf, sizeof( buf ), "%.17g", d );
+    data( buf );
+  }
+}
+
+void csvRow::endField() {
+  if ( in_header ) {
+    names.push_back( field.text );
+  }
+  else {
+    if ( field.kind == csvField::NUMBER && !field.text.empty() ) {
+      char buf[32];
+      snprintf( buf, sizeof( buf ), "%.17g", field.number );
+      field.text.insert( 0, buf );
+      field.literal = false;
+      field.kind = csvField::TEXT;
+    }
+    else if ( field.kind != csvField::NUMBER ) {
+      field.kind = ( field.literal && field.text == "NA" ) ? csvField::NA
+                                                            : csvField::TEXT;
+    }
+    values.push_back( std::move( field ) );
+  }
+  field = csvField();
+  started = false;
+}
+
+void csvRow::endRow() {
+  if ( started ) {
+    // the last field of a row that does not end in a comma
+    endField();
+  }
+  if ( in_header ) {
+    fields->header( names );
+    names.clear();
+    in_header = false;
+  }
+  else {
+    fields->row( values );
+    values.clear();
+  }
+}
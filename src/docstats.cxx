@@ -1,4 +1,11 @@
+#include <sstream>
+#include <algorithm>
 #include "tscan/stats.h"
+#include "tscan/arena.h"
+#include "tscan/csv.h"
+#include "tscan/columnar.h"
+#include "tscan/corpus.h"
+#include "tscan/spool.h"
 
 using namespace std;
 
@@ -7,88 +14,295 @@ using namespace std;
  ********/
 
 double docStats::rarity( int level ) const {
-  map<string,int>::const_iterator it = unique_lemmas.begin();
-  int rare = 0;
-  while ( it != unique_lemmas.end() ){
-    if ( it->second <= level )
-      ++rare;
-    ++it;
-  }
+  size_t rare = unique_lemmas.countAtMost( level );
   return rare / double( unique_lemmas.size() );
 }
 
+/********
+ * MEMORY
+ ********/
+
+/**
+ * Report the memory taken by the analysis of this document
+ * @param os    the stream to report to
+ * @param name  the name of the document
+ * @param arena the arena that holds the stats tree
+ */
+void docStats::memoryReport( ostream& os, const string& name,
+			     const StatsArena& arena ) const {
+  os << "memory use for " << name << ": " << doc_words.size() << " words of "
+     << sizeof( wordStats ) << " bytes, " << arena.capacity()
+     << " bytes in the stats tree; " << word_ids.size()
+     << " interned strings, about " << word_ids.bytes() << " bytes" << endl;
+}
+
 /************
  * CSV OUTPUT
  ************/
 
-void docStats::toCSV( const string& name, csvKind what ) const {
-  if ( what == DOC_CSV ){
-    string fname = name + ".document.csv";
-    ofstream out( fname.c_str() );
-    if ( out ){
-      // 20141003: New features: paragraphs/sentences/words per document
-      CSVheader( out, "Inputfile,Par_per_doc,Zin_per_doc,Word_per_doc" );
-      out << name << "," << sv.size() << ",";
-      structStats::toCSV( out );
-      cerr << "stored document statistics in " << fname << endl;
+static const char *csv_file_ext[] = { ".document.csv", ".paragraphs.csv",
+				      ".sentences.csv", ".words.csv" };
+static const char *csv_level[] = { "document", "paragraph",
+				   "sentence", "word" };
+static const char *columnar_file_ext[] = { ".document.tscol",
+					   ".paragraphs.tscol",
+					   ".sentences.tscol",
+					   ".words.tscol" };
+
+/**
+ * The columns of each kind of .csv output that hold text; all other
+ * columns hold numbers or NA
+ */
+const vector<string>& csvStringColumns( csvKind what ){
+  static const vector<string> columns[] = {
+    { "Inputfile", "Eigen_classificatie" },
+    { "Inputfile", "Segment", "Eigen_classificatie" },
+    { "Inputfile", "Segment", "Getokeniseerde_zin", "Eigen_classificatie" },
+    { "InputFile", "Segment", "Woord", "lemma", "Voll_lemma", "morfemen",
+      "Samenst_delen_Frog", "Wrdsoort", "Afk", "Conn_type", "Semtype_nw",
+      "Alg_nw", "Semtype_bvnw", "Semtype_ww", "Alg_ww", "Semtype_bw",
+      "Naam_NER", "Ww_vorm", "Vol_dw", "Onvol_dw", "Infin", "Formeel",
+      "Eigen_classificatie" } };
+  return columns[what];
+}
+
+/**
+ * Write the rows of one paragraph to a paragraph, sentence or word .csv
+ * @param out    the .csv file
+ * @param name   the name of the document
+ * @param par    the paragraph
+ * @param header true when the header line is still to be written, set
+ *               to false once it is
+ * @param what   the kind of .csv file
+ */
+static void paragraphToCSV( csvRow& out, const string& name,
+			    const basicStats *par, bool& header, csvKind what ){
+  if ( what == PAR_CSV ){
+    if ( header ){
+      // 20141003: New features: sentences/words per paragraph
+      out.startHeader();
+      par->CSVheader( out, "Inputfile,Segment,Zin_per_par,Wrd_per_par" );
+      header = false;
     }
-    else {
-      cerr << "storing document statistics in " << fname << " FAILED!" << endl;
+    out << name << "," << par->id << ",";
+    par->toCSV( out );
+  }
+  else if ( what == SENT_CSV ){
+    for ( size_t sent=0; sent < par->sv.size(); ++sent ){
+      if ( header ){
+	out.startHeader();
+	par->sv[sent]->CSVheader( out, "Inputfile,Segment,Getokeniseerde_zin" );
+	header = false;
+      }
+      out << name << "," << par->sv[sent]->id << ",";
+      par->sv[sent]->toCSV( out );
     }
   }
-  else if ( what == PAR_CSV ){
-    string fname = name + ".paragraphs.csv";
-    ofstream out( fname.c_str() );
-    if ( out ){
-      for ( size_t par=0; par < sv.size(); ++par ){
-	if ( par == 0 )
-    // 20141003: New features: sentences/words per paragraph
-	  sv[0]->CSVheader( out, "Inputfile,Segment,Zin_per_par,Wrd_per_par" );
-	out << name << "," << sv[par]->id << ",";
-	sv[par]->toCSV( out );
+  else if ( what == WORD_CSV ){
+    for ( size_t sent=0; sent < par->sv.size(); ++sent ){
+      for ( size_t word=0; word < par->sv[sent]->sv.size(); ++word ){
+	if ( header ){
+	  out.startHeader();
+	  par->sv[sent]->sv[word]->CSVheader( out );
+	  header = false;
+	}
+	out << name << ",";
+	par->sv[sent]->sv[word]->toCSV( out );
+      }
     }
-      cerr << "stored paragraph statistics in " << fname << endl;
+  }
+}
+
+/**
+ * Write one kind of .csv output of the document
+ * @param out  the text or typed rows
+ * @param name the name of the document
+ * @param what the kind of .csv output
+ */
+void docStats::toCSV( csvRow& out, const string& name, csvKind what ) const {
+  if ( what == DOC_CSV ){
+    // 20141003: New features: paragraphs/sentences/words per document
+    out.startHeader();
+    CSVheader( out, "Inputfile,Par_per_doc,Zin_per_doc,Word_per_doc" );
+    out << name << "," << parCnt << ",";
+    structStats::toCSV( out );
+  }
+  else {
+    bool header = true;
+    for ( size_t par=0; par < sv.size(); ++par ){
+      paragraphToCSV( out, name, sv[par], header, what );
     }
-    else {
-      cerr << "storing paragraph statistics in " << fname << " FAILED!" << endl;
+  }
+}
+
+void docStats::toCSV( const string& name, csvKind what ) const {
+  string fname = name + csv_file_ext[what];
+  csvFile out( fname );
+  if ( !out ){
+    cerr << "storing " << csv_level[what] << " statistics in " << fname
+	 << " FAILED!" << endl;
+    return;
+  }
+  csvRow rows( out );
+  toCSV( rows, name, what );
+  cerr << "stored " << csv_level[what] << " statistics in " << fname << endl;
+}
+
+/**
+ * The text of one kind of .csv output of the document
+ */
+string docStats::csvText( const string& name, csvKind what ) const {
+  ostringstream out;
+  csvStream( out );
+  csvRow rows( out );
+  toCSV( rows, name, what );
+  return out.str();
+}
+
+/**
+ * Write one kind of output of the document in columnar form
+ * @param out  the columnar file
+ * @param name the name of the document
+ * @param what the kind of .csv output
+ */
+void docStats::toColumns( ColumnarWriter& out, const string& name,
+			  csvKind what ) const {
+  ColumnarTable table( csvStringColumns( what ) );
+  csvRow rows( table );
+  toCSV( rows, name, what );
+  out.add( table );
+}
+
+/**
+ * @param doc_name   the name of the document
+ * @param what_kinds the kinds of .csv output to write
+ * @param corpus_csv the corpus output, or 0 for the .csv files of the
+ *                   document itself
+ */
+paragraphWriter::paragraphWriter( const string& doc_name,
+				  const vector<csvKind>& what_kinds,
+				  CorpusWriter *corpus_csv ):
+  name( doc_name ), kinds( what_kinds ), corpus( corpus_csv ) {
+  fill( headers, headers + WORD_CSV + 1, true );
+  fill( columns, columns + WORD_CSV + 1, nullptr );
+  for ( const csvKind what : kinds ){
+    if ( corpus ){
+      spools[what].reset( new spoolFile() );
+      if ( !spools[what]->good() ){
+	cerr << "spooling " << csv_level[what] << " statistics of " << name
+	     << " FAILED!" << endl;
+      }
+      continue;
+    }
+    string fname = name + csv_file_ext[what];
+    files[what].open( fname.c_str() );
+    if ( !files[what] ){
+      cerr << "storing " << csv_level[what] << " statistics in " << fname
+	   << " FAILED!" << endl;
     }
   }
-  else if ( what == SENT_CSV ){
-    string fname = name + ".sentences.csv";
-    ofstream out( fname.c_str() );
-    if ( out ){
-      for ( size_t par=0; par < sv.size(); ++par ){
-	for ( size_t sent=0; sent < sv[par]->sv.size(); ++sent ){
-	  if ( par == 0 && sent == 0 )
-	    sv[0]->sv[0]->CSVheader( out, "Inputfile,Segment,Getokeniseerde_zin" );
-	  out << name << "," << sv[par]->sv[sent]->id << ",";
-	  sv[par]->sv[sent]->toCSV( out );
-	}
+}
+
+/**
+ * Write the columnar output instead, a row group per paragraph
+ * @param doc_name   the name of the document
+ * @param what_kinds the kinds of output to write
+ * @param corpus_columns the columnar file of each kind for the whole
+ *                       corpus, or 0 for the files of the document itself
+ */
+paragraphWriter::paragraphWriter( const string& doc_name,
+				  const vector<csvKind>& what_kinds,
+				  ColumnarWriter *const *corpus_columns ):
+  name( doc_name ), kinds( what_kinds ), corpus( 0 ) {
+  fill( headers, headers + WORD_CSV + 1, true );
+  fill( columns, columns + WORD_CSV + 1, nullptr );
+  for ( const csvKind what : kinds ){
+    if ( corpus_columns && corpus_columns[what] ){
+      columns[what] = corpus_columns[what];
+      spools[what].reset( new spoolFile() );
+      if ( !spools[what]->good() ){
+	cerr << "spooling " << csv_level[what] << " statistics of " << name
+	     << " FAILED!" << endl;
       }
-      cerr << "stored sentence statistics in " << fname << endl;
+      continue;
+    }
+    string fname = name + columnar_file_ext[what];
+    own_columns[what].reset( new ColumnarWriter( fname ) );
+    if ( own_columns[what]->good() ){
+      columns[what] = own_columns[what].get();
     }
     else {
-      cerr << "storing sentence statistics in " << fname << " FAILED!" << endl;
+      cerr << "storing " << csv_level[what] << " statistics in " << fname
+	   << " FAILED!" << endl;
     }
   }
-  else if ( what == WORD_CSV ){
-    string fname = name + ".words.csv";
-    ofstream out( fname.c_str() );
-    if ( out ){
-      for ( size_t par=0; par < sv.size(); ++par ){
-	for ( size_t sent=0; sent < sv[par]->sv.size(); ++sent ){
-	  for ( size_t word=0; word < sv[par]->sv[sent]->sv.size(); ++word ){
-	    if ( par == 0 && sent == 0 && word == 0 )
-	      sv[0]->sv[0]->sv[0]->CSVheader( out );
-	    out << name << ",";
-	    sv[par]->sv[sent]->sv[word]->toCSV( out );
-	  }
-	}
+}
+
+/**
+ * Write the paragraph, its sentences and its words, so the paragraph
+ * can be freed.
+ */
+void paragraphWriter::add( const parStats *par ){
+  for ( const csvKind what : kinds ){
+    if ( columns[what] ){
+      // each row group has the header that sets its columns
+      ColumnarTable table( csvStringColumns( what ) );
+      csvRow rows( table );
+      bool header = true;
+      paragraphToCSV( rows, name, par, header, what );
+      if ( spools[what] ){
+	columns[what]->spool( table, *spools[what] );
+      }
+      else {
+	columns[what]->add( table );
       }
-      cerr << "stored word statistics in " << fname << endl;
     }
-    else {
-      cerr << "storing word statistics in " << fname << " FAILED!" << endl;
+    else if ( corpus ){
+      ostringstream text;
+      csvStream( text );
+      csvRow rows( text );
+      paragraphToCSV( rows, name, par, headers[what], what );
+      spools[what]->write( text.str() );
+    }
+    else if ( files[what].is_open() ){
+      csvRow rows( files[what] );
+      paragraphToCSV( rows, name, par, headers[what], what );
+    }
+  }
+}
+
+/**
+ * Add the spooled rows of the finished document to the corpus output.
+ * Without a commit, e.g. when the analysis of the document failed, the
+ * spools are dropped and the corpus does not get a part of the document.
+ */
+void paragraphWriter::commit(){
+  if ( corpus ){
+    vector<spoolFile*> parts( WORD_CSV + 1, nullptr );
+    for ( const csvKind what : kinds ){
+      parts[what] = spools[what].get();
+    }
+    corpus->add( parts );
+    return;
+  }
+  for ( const csvKind what : kinds ){
+    if ( spools[what] && columns[what] ){
+      columns[what]->add( *spools[what] );
+    }
+  }
+}
+
+paragraphWriter::~paragraphWriter(){
+  for ( const csvKind what : kinds ){
+    if ( own_columns[what] && columns[what] ){
+      own_columns[what].reset();
+      cerr << "stored " << csv_level[what] << " statistics in "
+	   << name << columnar_file_ext[what] << endl;
+    }
+    else if ( files[what].is_open() ){
+      files[what].close();
+      cerr << "stored " << csv_level[what] << " statistics in "
+	   << name << csv_file_ext[what] << endl;
     }
   }
 }
@@ -101,121 +315,121 @@ void docStats::addMetrics() const {
   folia::FoliaElement *el = folia_node;
   structStats::addMetrics();
   addOneMetric( el->doc(), el,
-		"sentence_count", TiCC::toString( sentCnt ) );
+		"sentence_count", sentCnt );
   addOneMetric( el->doc(), el,
-		"paragraph_count", TiCC::toString( sv.size() ) );
+		"paragraph_count", parCnt );
   addOneMetric( el->doc(), el,
-		"word_ttr", TiCC::toString( unique_words.size()/double(wordInclCnt) ) );
+		"word_ttr", unique_words.size()/double(wordInclCnt) );
   addOneMetric( el->doc(), el,
-		"word_mtld", TiCC::toString( word_mtld ) );
+		"word_mtld", word_mtld );
   addOneMetric( el->doc(), el,
-		"lemma_ttr", TiCC::toString( unique_lemmas.size()/double(wordInclCnt) ) );
+		"lemma_ttr", unique_lemmas.size()/double(wordInclCnt) );
   addOneMetric( el->doc(), el,
-		"lemma_mtld", TiCC::toString( lemma_mtld ) );
+		"lemma_mtld", lemma_mtld );
   if ( nameCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "names_ttr", TiCC::toString( unique_names.size()/double(nameInclCnt) ) );
+		  "names_ttr", unique_names.size()/double(nameInclCnt) );
   }
   addOneMetric( el->doc(), el,
-		"name_mtld", TiCC::toString( name_mtld ) );
+		"name_mtld", name_mtld );
 
   if ( contentInclCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "content_word_ttr", TiCC::toString( unique_contents.size()/double(contentInclCnt) ) );
+		  "content_word_ttr", unique_contents.size()/double(contentInclCnt) );
   }
   if ( contentStrictInclCnt != 0 ){
     addOneMetric( el->doc(), el,
-      "content_word_ttr_strict", TiCC::toString( unique_contents_strict.size()/double(contentStrictInclCnt) ) );
+      "content_word_ttr_strict", unique_contents_strict.size()/double(contentStrictInclCnt) );
   }
 
   addOneMetric( el->doc(), el,
-		"content_mtld", TiCC::toString( content_mtld ) );
+		"content_mtld", content_mtld );
   addOneMetric( el->doc(), el,
-    "content_mtld_strict", TiCC::toString( content_mtld_strict ) );
+    "content_mtld_strict", content_mtld_strict );
 
   if ( timeSitCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "time_sit_ttr", TiCC::toString( unique_tijd_sits.size()/double(timeSitCnt) ) );
+		  "time_sit_ttr", unique_tijd_sits.size()/double(timeSitCnt) );
   }
   addOneMetric( el->doc(), el,
-		"tijd_sit_mtld", TiCC::toString( tijd_sit_mtld ) );
+		"tijd_sit_mtld", tijd_sit_mtld );
 
   if ( spaceSitCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "space_sit_ttr", TiCC::toString( unique_ruimte_sits.size()/double(spaceSitCnt) ) );
+		  "space_sit_ttr", unique_ruimte_sits.size()/double(spaceSitCnt) );
   }
   addOneMetric( el->doc(), el,
-		"ruimte_sit_mtld", TiCC::toString( ruimte_sit_mtld ) );
+		"ruimte_sit_mtld", ruimte_sit_mtld );
 
   if ( causeSitCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "cause_sit_ttr", TiCC::toString( unique_cause_sits.size()/double(causeSitCnt) ) );
+		  "cause_sit_ttr", unique_cause_sits.size()/double(causeSitCnt) );
   }
   addOneMetric( el->doc(), el,
-		"cause_sit_mtld", TiCC::toString( cause_sit_mtld ) );
+		"cause_sit_mtld", cause_sit_mtld );
 
   if ( emoSitCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "emotion_sit_ttr", TiCC::toString( unique_emotion_sits.size()/double(emoSitCnt) ) );
+		  "emotion_sit_ttr", unique_emotion_sits.size()/double(emoSitCnt) );
   }
   addOneMetric( el->doc(), el,
-		"emotion_sit_mtld", TiCC::toString( emotion_sit_mtld ) );
+		"emotion_sit_mtld", emotion_sit_mtld );
 
   if ( allConnCnt != 0 ){
     addOneMetric( el->doc(), el,
-      "all_conn_ttr", TiCC::toString( unique_all_conn.size()/double(allConnCnt) ) );
+      "all_conn_ttr", unique_all_conn.size()/double(allConnCnt) );
   }
   addOneMetric( el->doc(), el,
-    "all_conn_mtld", TiCC::toString(all_conn_mtld) );
+    "all_conn_mtld", all_conn_mtld );
 
   if ( tempConnCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "temp_conn_ttr", TiCC::toString( unique_temp_conn.size()/double(tempConnCnt) ) );
+		  "temp_conn_ttr", unique_temp_conn.size()/double(tempConnCnt) );
   }
   addOneMetric( el->doc(), el,
-		"temp_conn_mtld", TiCC::toString(temp_conn_mtld) );
+		"temp_conn_mtld", temp_conn_mtld );
 
   if ( opsomWgConnCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "opsom_wg_conn_ttr", TiCC::toString( unique_reeks_wg_conn.size()/double(opsomWgConnCnt) ) );
+		  "opsom_wg_conn_ttr", unique_reeks_wg_conn.size()/double(opsomWgConnCnt) );
   }
   addOneMetric( el->doc(), el,
-		"opsom_wg_conn_mtld", TiCC::toString(reeks_wg_conn_mtld) );
+		"opsom_wg_conn_mtld", reeks_wg_conn_mtld );
 
   if ( opsomZinConnCnt != 0 ){
     addOneMetric( el->doc(), el,
-      "opsom_zin_conn_ttr", TiCC::toString( unique_reeks_zin_conn.size()/double(opsomZinConnCnt) ) );
+      "opsom_zin_conn_ttr", unique_reeks_zin_conn.size()/double(opsomZinConnCnt) );
   }
   addOneMetric( el->doc(), el,
-    "opsom_zin_conn_mtld", TiCC::toString(reeks_zin_conn_mtld) );
+    "opsom_zin_conn_mtld", reeks_zin_conn_mtld );
 
   if ( contrastConnCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "contrast_conn_ttr", TiCC::toString( unique_contr_conn.size()/double(contrastConnCnt) ) );
+		  "contrast_conn_ttr", unique_contr_conn.size()/double(contrastConnCnt) );
   }
   addOneMetric( el->doc(), el,
-		"contrast_conn_mtld", TiCC::toString(contr_conn_mtld) );
+		"contrast_conn_mtld", contr_conn_mtld );
 
   if ( compConnCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "comp_conn_ttr", TiCC::toString( unique_comp_conn.size()/double(compConnCnt) ) );
+		  "comp_conn_ttr", unique_comp_conn.size()/double(compConnCnt) );
   }
   addOneMetric( el->doc(), el,
-		"comp_conn_mtld", TiCC::toString(comp_conn_mtld) );
+		"comp_conn_mtld", comp_conn_mtld );
 
 
   if ( causeConnCnt != 0 ){
     addOneMetric( el->doc(), el,
-		  "cause_conn_ttr", TiCC::toString( unique_cause_conn.size()/double(causeConnCnt) ) );
+		  "cause_conn_ttr", unique_cause_conn.size()/double(causeConnCnt) );
   }
   addOneMetric( el->doc(), el,
-		"cause_conn_mtld", TiCC::toString( cause_conn_mtld ) );
+		"cause_conn_mtld", cause_conn_mtld );
 
 
   addOneMetric( el->doc(), el,
-		"rar_index", TiCC::toString( rarity_index ) );
+		"rar_index", rarity_index );
   addOneMetric( el->doc(), el,
-		"document_word_argument_overlap_count", TiCC::toString( doc_word_overlapCnt ) );
+		"document_word_argument_overlap_count", doc_word_overlapCnt );
   addOneMetric( el->doc(), el,
-		"document_lemma_argument_overlap_count", TiCC::toString( doc_lemma_overlapCnt ) );
+		"document_lemma_argument_overlap_count", doc_lemma_overlapCnt );
 }
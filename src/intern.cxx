@@ -0,0 +1,189 @@
+#include <stdexcept>
+#include "tscan/intern.h"
+
+using namespace std;
+
+StringInterner word_ids;
+
+const uint32_t IdCounter::empty_slot;
+
+StringInterner::StringInterner():
+  chars( 0 ), limit( 0 ), leases( 0 ), count( 0 ), gen( 0 ) {
+  for ( size_t i = 0; i < max_chunks; ++i ) {
+    chunks[i].store( 0 );
+  }
+  id( "" );
+}
+
+StringInterner::~StringInterner() {
+  for ( size_t i = 0; i < max_chunks; ++i ) {
+    delete [] chunks[i].load();
+  }
+}
+
+/**
+ * Get the id of a string, giving it a new one when it is not yet known
+ */
+uint32_t StringInterner::id( const string& s ) {
+  lock_guard<mutex> lock( mtx );
+  return add( s );
+}
+
+/**
+ * id() for a caller that holds the lock
+ */
+uint32_t StringInterner::add( const string& s ) {
+  auto it = ids.find( s );
+  if ( it != ids.end() ) {
+    return it->second;
+  }
+  size_t result = count.load( memory_order_relaxed );
+  if ( ( result >> chunk_bits ) >= max_chunks ) {
+    throw runtime_error( "too many different words and lemmas" );
+  }
+  const string **chunk = chunks[result >> chunk_bits].load( memory_order_relaxed );
+  if ( !chunk ) {
+    chunk = new const string*[chunk_mask + 1];
+    chunks[result >> chunk_bits].store( chunk, memory_order_release );
+  }
+  it = ids.insert( make_pair( s, uint32_t( result ) ) ).first;
+  // the keys of an unordered_map don't move, so we can point at them
+  chunk[result & chunk_mask] = &it->first;
+  chars += s.size();
+  count.store( result + 1, memory_order_release );
+  return result;
+}
+
+/**
+ * An estimate of the memory used: the characters, plus a hash node, a
+ * string and a pointer per string
+ */
+size_t StringInterner::bytes() const {
+  lock_guard<mutex> lock( mtx );
+  return chars + size() * ( sizeof( pair<const string, uint32_t> )
+                            + 2 * sizeof( void * )
+                            + sizeof( const string * ) );
+}
+
+/**
+ * Forget all strings, and start a new generation. Only called when no
+ * Lease is held, so nobody looks at the old ids anymore.
+ */
+void StringInterner::clear() {
+  for ( size_t i = 0; i < max_chunks; ++i ) {
+    delete [] chunks[i].load();
+    chunks[i].store( 0 );
+  }
+  ids.clear();
+  chars = 0;
+  count.store( 0 );
+  gen.store( gen.load() + 1, memory_order_release );
+  add( "" );
+}
+
+StringInterner::Lease::Lease( StringInterner& si ): owner( si ) {
+  unique_lock<mutex> lock( owner.mtx );
+  if ( owner.limit > 0 && owner.size() > owner.limit ) {
+    while ( owner.leases > 0 ) {
+      owner.released.wait( lock );
+    }
+    // another Lease may have started the new generation while we waited
+    if ( owner.size() > owner.limit ) {
+      owner.clear();
+    }
+  }
+  ++owner.leases;
+}
+
+StringInterner::Lease::~Lease() {
+  lock_guard<mutex> lock( owner.mtx );
+  if ( --owner.leases == 0 ) {
+    owner.released.notify_all();
+  }
+}
+
+/**
+ * Find the slot of an id: where it is, or the empty one where it belongs
+ */
+size_t IdCounter::slot( uint32_t id ) const {
+  size_t mask = keys.size() - 1;
+  size_t i = ( id * 2654435761u ) & mask;
+  while ( keys[i] != empty_slot && keys[i] != id ) {
+    i = ( i + 1 ) & mask;
+  }
+  return i;
+}
+
+void IdCounter::grow() {
+  vector<uint32_t> old_keys;
+  vector<int> old_counts;
+  old_keys.swap( keys );
+  old_counts.swap( counts );
+  keys.assign( old_keys.empty() ? 16 : 2 * old_keys.size(), empty_slot );
+  counts.assign( keys.size(), 0 );
+  for ( size_t i = 0; i < old_keys.size(); ++i ) {
+    if ( old_keys[i] != empty_slot ) {
+      size_t s = slot( old_keys[i] );
+      keys[s] = old_keys[i];
+      counts[s] = old_counts[i];
+    }
+  }
+}
+
+void IdCounter::add( uint32_t id, int count ) {
+  // keep the table at most 3/4 full
+  if ( 4 * ( used + 1 ) > 3 * keys.size() ) {
+    grow();
+  }
+  size_t s = slot( id );
+  if ( keys[s] == empty_slot ) {
+    keys[s] = id;
+    ++used;
+  }
+  counts[s] += count;
+}
+
+/**
+ * Add the counts of another counter. The smaller of the two tables is
+ * walked: when 'other' is the larger one, we start from a copy of it and
+ * add our own counts to that.
+ */
+void IdCounter::merge( const IdCounter& other ) {
+  if ( other.used > used ) {
+    IdCounter result( other );
+    result.merge( *this );
+    swap( keys, result.keys );
+    swap( counts, result.counts );
+    used = result.used;
+    return;
+  }
+  for ( size_t i = 0; i < other.keys.size(); ++i ) {
+    if ( other.keys[i] != empty_slot ) {
+      add( other.keys[i], other.counts[i] );
+    }
+  }
+}
+
+/**
+ * The count of an id, 0 when it was never added
+ */
+int IdCounter::count( uint32_t id ) const {
+  if ( keys.empty() ) {
+    return 0;
+  }
+  size_t s = slot( id );
+  return keys[s] == id ? counts[s] : 0;
+}
+
+/**
+ * The number of ids that occur 'level' times or less
+ */
+size_t IdCounter::countAtMost( int level ) const {
+  size_t result = 0;
+  for ( size_t i = 0; i < keys.size(); ++i ) {
+    if ( keys[i] != empty_slot && counts[i] <= level ) {
+      ++result;
+    }
+  }
+  return result;
+}
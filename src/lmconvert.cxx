@@ -0,0 +1,31 @@
+/*
+  tscan-lmconvert: convert an ARPA language model for use by tscan
+*/
+
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include "tscan/ngram.h"
+
+using namespace std;
+
+int main( int argc, char *argv[] ) {
+  if ( argc != 3 ) {
+    cerr << "usage: tscan-lmconvert <model.arpa> <model.tslm>" << endl;
+    cerr << "\tconvert an ARPA language model to the binary format used by tscan" << endl;
+    cerr << "\t(see the ngram section of the configuration)." << endl;
+    exit( EXIT_FAILURE );
+  }
+  ifstream is( argv[1] );
+  if ( !is ) {
+    cerr << "unable to open '" << argv[1] << "'" << endl;
+    exit( EXIT_FAILURE );
+  }
+  string message;
+  if ( !NgramModel::convertArpa( is, argv[2], message ) ) {
+    cerr << "conversion failed: " << message << endl;
+    exit( EXIT_FAILURE );
+  }
+  exit( EXIT_SUCCESS );
+}
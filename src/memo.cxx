@@ -0,0 +1,174 @@
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include "tscan/memo.h"
+
+using namespace std;
+
+MemoCache::MemoCache( const string& n ):
+  name( n ), fd( -1 ), offset( 0 ), hits( 0 ), misses( 0 ) {
+}
+
+MemoCache::~MemoCache() {
+  if ( fd >= 0 ) {
+    close( fd );
+  }
+}
+
+/**
+ * Escape tabs, newlines and backslashes, so every entry fits on one line
+ */
+static string escape( const string& s ) {
+  string result;
+  for ( const auto& c : s ) {
+    if ( c == '\\' ) {
+      result += "\\\\";
+    }
+    else if ( c == '\t' ) {
+      result += "\\t";
+    }
+    else if ( c == '\n' ) {
+      result += "\\n";
+    }
+    else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+static string unescape( const string& s ) {
+  string result;
+  for ( size_t i = 0; i < s.size(); ++i ) {
+    if ( s[i] == '\\' && i + 1 < s.size() ) {
+      ++i;
+      if ( s[i] == 't' ) {
+        result += '\t';
+      }
+      else if ( s[i] == 'n' ) {
+        result += '\n';
+      }
+      else {
+        result += s[i];
+      }
+    }
+    else {
+      result += s[i];
+    }
+  }
+  return result;
+}
+
+/**
+ * Attach the cache to its file in 'dir' and read what is there
+ * @param dir     the cache directory
+ * @param version the version of the backend (method, model, ...)
+ */
+void MemoCache::open( const string& dir, const string& version ) {
+  lock_guard<mutex> lock( mtx );
+  string tag = version;
+  for ( auto& c : tag ) {
+    if ( c == '/' || c == ' ' ) {
+      c = '_';
+    }
+  }
+  filename = dir + "/" + name + "." + tag + ".memo";
+  fd = ::open( filename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0664 );
+  if ( fd < 0 ) {
+    cerr << "unable to open cache file '" << filename << "': "
+         << strerror( errno ) << ". Continuing without it." << endl;
+    return;
+  }
+  readNew();
+}
+
+/**
+ * Read the entries appended (by any process) since the last read.
+ * Only complete lines are taken; mtx must be held.
+ */
+void MemoCache::readNew() {
+  if ( fd < 0 ) {
+    return;
+  }
+  flock( fd, LOCK_SH );
+  string data;
+  char buf[65536];
+  ssize_t n;
+  while ( ( n = pread( fd, buf, sizeof( buf ), offset + data.size() ) ) > 0 ) {
+    data.append( buf, n );
+  }
+  flock( fd, LOCK_UN );
+  size_t start = 0;
+  size_t pos;
+  while ( ( pos = data.find( '\n', start ) ) != string::npos ) {
+    size_t tab = data.find( '\t', start );
+    if ( tab != string::npos && tab < pos ) {
+      entries[unescape( data.substr( start, tab - start ) )]
+        = unescape( data.substr( tab + 1, pos - tab - 1 ) );
+    }
+    start = pos + 1;
+  }
+  offset += start;
+}
+
+/**
+ * Look up a key
+ * @param key   the key
+ * @param value the cached value, when found
+ * @return true when found
+ */
+bool MemoCache::lookup( const string& key, string& value ) {
+  lock_guard<mutex> lock( mtx );
+  auto it = entries.find( key );
+  if ( it == entries.end() ) {
+    readNew();
+    it = entries.find( key );
+  }
+  if ( it == entries.end() ) {
+    ++misses;
+    return false;
+  }
+  ++hits;
+  value = it->second;
+  return true;
+}
+
+/**
+ * Check for a key, without counting it as a hit or a miss
+ */
+bool MemoCache::contains( const string& key ) {
+  lock_guard<mutex> lock( mtx );
+  if ( entries.find( key ) == entries.end() ) {
+    readNew();
+  }
+  return entries.find( key ) != entries.end();
+}
+
+/**
+ * Store a value, both in memory and in the file
+ */
+void MemoCache::store( const string& key, const string& value ) {
+  lock_guard<mutex> lock( mtx );
+  entries[key] = value;
+  if ( fd < 0 ) {
+    return;
+  }
+  string line = escape( key ) + "\t" + escape( value ) + "\n";
+  flock( fd, LOCK_EX );
+  ssize_t res = write( fd, line.data(), line.size() );
+  flock( fd, LOCK_UN );
+  if ( res != (ssize_t)line.size() ) {
+    cerr << "unable to write to cache file '" << filename << "'" << endl;
+  }
+}
+
+void MemoCache::report( ostream& os ) const {
+  lock_guard<mutex> lock( mtx );
+  os << name << " cache: " << hits << " hits, " << misses << " misses";
+  if ( !filename.empty() ) {
+    os << " (" << filename << ")";
+  }
+  os << endl;
+}
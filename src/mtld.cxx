@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "tscan/mtld.h"
+
+using namespace std;
+
+// below this number of tokens, starting threads costs more than it gains
+const size_t mtld_parallel_min = 20000;
+
+/**
+ * The set of types in the current factor. An id is in the set when its
+ * stamp equals the current generation, so clearing the set is just
+ * moving on to the next generation.
+ */
+class SeenTable {
+public:
+  SeenTable(): generation( 0 ) {};
+  void clear() {
+    if ( ++generation == 0 ) {
+      // wrapped around: the old stamps could match again
+      fill( stamps.begin(), stamps.end(), 0 );
+      generation = 1;
+    }
+  }
+  bool insert( uint32_t id ) {
+    if ( id >= stamps.size() ) {
+      stamps.resize( max( size_t( id ) + 1, 2 * stamps.size() ), 0 );
+    }
+    if ( stamps[id] == generation ) {
+      return false;
+    }
+    stamps[id] = generation;
+    return true;
+  }
+private:
+  vector<uint32_t> stamps;
+  uint32_t generation;
+};
+
+/**
+ * The MTLD computation in one direction
+ */
+class MtldFactors {
+public:
+  MtldFactors( double t, SeenTable& s ):
+    threshold( t ), seen( s ), token_count( 0 ), type_count( 0 ),
+    factor( 0.0 ) {
+    seen.clear();
+  }
+  void add( uint32_t id, bool last ) {
+    ++token_count;
+    if ( seen.insert( id ) ) {
+      ++type_count;
+    }
+    double token_ttr = type_count / double( token_count );
+    if ( token_ttr <= threshold ) {
+#ifdef KOIZUMI
+      if ( token_count >= 10 ) {
+        factor += 1.0;
+      }
+#else
+      factor += 1.0;
+#endif
+      token_count = 0;
+      type_count = 0;
+      seen.clear();
+    }
+    else if ( last ) {
+      // partial result
+      factor += ( 1 - token_ttr ) / ( 1 - threshold );
+    }
+  }
+  double result( size_t size ) const {
+    return size / ( factor == 0.0 ? 1.0 : factor );
+  }
+private:
+  double threshold;
+  SeenTable& seen;
+  int token_count;
+  size_t type_count;
+  double factor;
+};
+
+/**
+ * Calculate the MTLD of a series, as the average of the forward and the
+ * backward MTLD
+ * @param series    the token ids
+ * @param threshold the TTR at which a factor is complete
+ */
+double average_mtld( const mtld_series& series, double threshold ) {
+  if ( series.empty() ) {
+    return 0.0;
+  }
+  static thread_local SeenTable fwd_seen;
+  static thread_local SeenTable bwd_seen;
+  MtldFactors fwd( threshold, fwd_seen );
+  MtldFactors bwd( threshold, bwd_seen );
+  const size_t n = series.size();
+  for ( size_t i = 0; i < n; ++i ) {
+    fwd.add( series[i], i == n - 1 );
+    bwd.add( series[n - 1 - i], i == n - 1 );
+  }
+  return ( fwd.result( n ) + bwd.result( n ) ) / 2.0;
+}
+
+/**
+ * Calculate the MTLD of several series
+ * @param series    the token ids of each series
+ * @param threshold the TTR at which a factor is complete
+ * @return the MTLD of each series
+ */
+vector<double> average_mtlds( const vector<mtld_series>& series,
+                              double threshold ) {
+  vector<double> result( series.size(), 0.0 );
+  size_t total = 0;
+  for ( const auto& s : series ) {
+    total += s.size();
+  }
+  size_t workers = min<size_t>( thread::hardware_concurrency(), series.size() );
+  if ( total < mtld_parallel_min || workers < 2 ) {
+    for ( size_t i = 0; i < series.size(); ++i ) {
+      result[i] = average_mtld( series[i], threshold );
+    }
+    return result;
+  }
+  // longest series first, so they don't end up last on a single thread
+  vector<size_t> order( series.size() );
+  for ( size_t i = 0; i < order.size(); ++i ) {
+    order[i] = i;
+  }
+  sort( order.begin(), order.end(),
+        [&series]( size_t a, size_t b ) {
+          return series[a].size() > series[b].size();
+        } );
+  atomic<size_t> next( 0 );
+  auto work = [&]() {
+    size_t i;
+    while ( ( i = next++ ) < order.size() ) {
+      result[order[i]] = average_mtld( series[order[i]], threshold );
+    }
+  };
+  vector<thread> threads;
+  for ( size_t t = 1; t < workers; ++t ) {
+    threads.push_back( thread( work ) );
+  }
+  work();
+  for ( auto& t : threads ) {
+    t.join();
+  }
+  return result;
+}
@@ -1,3 +1,4 @@
+#include <unordered_map>
 #include "tscan/ner.h"
 
 using namespace std;
@@ -5,35 +6,62 @@ using namespace std;
 namespace NER {
   const string frog_ner_set = "http://ilk.uvt.nl/folia/sets/frog-ner-nl";
 
-  Type lookupNer(const folia::Word *w, const folia::Sentence *s) {
-    Type result = NONER;
+  /**
+   * The B(egin) and I(nside) types of an entity class
+   */
+  static void nerTypes( const string& cls, Type& begin, Type& inside ) {
+    if ( cls == "org" ) {
+      begin = ORG_B; inside = ORG_I;
+    }
+    else if ( cls == "eve" ) {
+      begin = EVE_B; inside = EVE_I;
+    }
+    else if ( cls == "loc" ) {
+      begin = LOC_B; inside = LOC_I;
+    }
+    else if ( cls == "misc" ) {
+      begin = MISC_B; inside = MISC_I;
+    }
+    else if ( cls == "per" ) {
+      begin = PER_B; inside = PER_I;
+    }
+    else if ( cls == "pro" ) {
+      begin = PRO_B; inside = PRO_I;
+    }
+    else {
+      throw folia::ValueError( "unknown NER class: " + cls );
+    }
+  }
+
+  /**
+   * Resolve the entity layer of a sentence once, instead of scanning all
+   * entities for every word
+   * @param words the words of the sentence
+   * @param s     the sentence
+   * @return the NER type of each word, by position. When a word is in
+   * more than one entity, the last one wins.
+   */
+  Index indexNers( const vector<folia::Word*>& words, const folia::Sentence *s ) {
+    Index result( words.size(), NONER );
     vector<folia::Entity*> v = s->select<folia::Entity>(frog_ner_set);
+    if ( v.empty() ) {
+      return result;
+    }
+    unordered_map<const folia::FoliaElement*, size_t> positions;
+    for ( size_t i=0; i < words.size(); ++i ) {
+      positions[words[i]] = i;
+    }
     for ( size_t i=0; i < v.size(); ++i ) {
       folia::FoliaElement *e = v[i];
+      Type begin = NONER;
+      Type inside = NONER;
       for ( size_t j=0; j < e->size(); ++j ) {
-        if ( e->index(j) == w ){
-          string cls = v[i]->cls();
-          if ( cls == "org" ) {
-            result = j == 0 ? ORG_B : ORG_I;
-          }
-          else if ( cls == "eve" ) {
-            result = j == 0 ? EVE_B : EVE_I;
-          }
-          else if ( cls == "loc" ) {
-            result = j == 0 ? LOC_B : LOC_I;
-          }
-          else if ( cls == "misc" ) {
-            result = j == 0 ? MISC_B : MISC_I;
-          }
-          else if ( cls == "per" ) {
-            result = j == 0 ? PER_B : PER_I;
-          }
-          else if ( cls == "pro" ) {
-            result = j == 0 ? PRO_B : PRO_I;
-          }
-          else {
-            throw folia::ValueError( "unknown NER class: " + cls );
+        auto it = positions.find( e->index(j) );
+        if ( it != positions.end() ) {
+          if ( begin == NONER ) {
+            nerTypes( v[i]->cls(), begin, inside );
           }
+          result[it->second] = j == 0 ? begin : inside;
         }
       }
     }
@@ -0,0 +1,455 @@
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tscan/ngram.h"
+
+using namespace std;
+
+const char lm_magic[8] = { 'T', 'S', 'C', 'A', 'N', 'L', 'M', '1' };
+const size_t max_order = 8;
+const uint32_t no_word = 0xffffffff;
+
+struct lm_header {
+  char magic[8];
+  uint32_t order;
+  uint32_t flags;
+  uint64_t vocab_size;
+  uint64_t vocab_bytes;
+  uint64_t counts[max_order];
+};
+
+inline size_t recordSize( size_t n ) {
+  // n word ids, followed by the log10 prob and the log10 backoff
+  return n * sizeof( uint32_t ) + 2 * sizeof( float );
+}
+
+inline size_t align8( size_t s ) {
+  return ( s + 7 ) & ~size_t( 7 );
+}
+
+NgramModel::NgramModel():
+  base( 0 ), size( 0 ), backward( false ), order( 0 ), vocab_size( 0 ),
+  vocab_offsets( 0 ), vocab_chars( 0 ), unk( no_word ), start( no_word ),
+  oov_prob10( NAN ) {
+}
+
+NgramModel::~NgramModel() {
+  if ( base ) {
+    munmap( const_cast<char *>( base ), size );
+  }
+}
+
+/**
+ * Map a model file into memory
+ * @param filename the file made by convertArpa()
+ * @param bwd      true for a model trained on reversed sentences
+ * @param message  the reason of failure
+ * @return true on success
+ */
+bool NgramModel::load( const string& filename, bool bwd, string& message ) {
+  int fd = open( filename.c_str(), O_RDONLY );
+  if ( fd < 0 ) {
+    message = "unable to open '" + filename + "': " + strerror( errno );
+    return false;
+  }
+  struct stat sbuf;
+  if ( fstat( fd, &sbuf ) != 0 || (size_t)sbuf.st_size < sizeof( lm_header ) ) {
+    message = "'" + filename + "' is not a language model";
+    close( fd );
+    return false;
+  }
+  size = sbuf.st_size;
+  void *map = mmap( 0, size, PROT_READ, MAP_SHARED, fd, 0 );
+  close( fd );
+  if ( map == MAP_FAILED ) {
+    message = "unable to map '" + filename + "': " + strerror( errno );
+    return false;
+  }
+  base = static_cast<const char *>( map );
+  const lm_header *h = reinterpret_cast<const lm_header *>( base );
+  size_t expected = sizeof( lm_header );
+  if ( memcmp( h->magic, lm_magic, sizeof( lm_magic ) ) == 0
+       && h->order > 0 && h->order <= max_order ) {
+    expected += ( h->vocab_size + 1 ) * sizeof( uint64_t );
+    expected = align8( expected + h->vocab_bytes );
+    for ( size_t n = 1; n <= h->order; ++n ) {
+      expected += h->counts[n - 1] * recordSize( n );
+    }
+  }
+  if ( expected != size ) {
+    message = "'" + filename + "' is not a valid language model";
+    munmap( map, size );
+    base = 0;
+    return false;
+  }
+  backward = bwd;
+  order = h->order;
+  vocab_size = h->vocab_size;
+  const char *p = base + sizeof( lm_header );
+  vocab_offsets = reinterpret_cast<const uint64_t *>( p );
+  p += ( vocab_size + 1 ) * sizeof( uint64_t );
+  vocab_chars = p;
+  p = base + align8( p - base + h->vocab_bytes );
+  tables.clear();
+  counts.clear();
+  for ( size_t n = 1; n <= order; ++n ) {
+    tables.push_back( p );
+    counts.push_back( h->counts[n - 1] );
+    p += h->counts[n - 1] * recordSize( n );
+  }
+  unk = wordId( "<unk>" );
+  start = wordId( "<s>" );
+  // without <unk>, an unknown word gets the lowest unigram probability
+  // (ignoring the -99 of <s>)
+  oov_prob10 = NAN;
+  const size_t rs = recordSize( 1 );
+  for ( uint64_t i = 0; i < counts[0]; ++i ) {
+    const float *rec = reinterpret_cast<const float *>( tables[0] + i * rs
+                                                        + sizeof( uint32_t ) );
+    if ( rec[0] > -99 && !( rec[0] >= oov_prob10 ) ) {
+      oov_prob10 = rec[0];
+    }
+  }
+  return true;
+}
+
+uint32_t NgramModel::wordId( const string& word ) const {
+  uint64_t lo = 0;
+  uint64_t hi = vocab_size;
+  while ( lo < hi ) {
+    uint64_t mid = lo + ( hi - lo ) / 2;
+    int cmp = word.compare( 0, string::npos, vocab_chars + vocab_offsets[mid],
+                            vocab_offsets[mid + 1] - vocab_offsets[mid] );
+    if ( cmp == 0 ) {
+      return mid;
+    }
+    if ( cmp < 0 ) {
+      hi = mid;
+    }
+    else {
+      lo = mid + 1;
+    }
+  }
+  return no_word;
+}
+
+static int compareIds( const uint32_t *a, const uint32_t *b, size_t n ) {
+  for ( size_t i = 0; i < n; ++i ) {
+    if ( a[i] != b[i] ) {
+      return a[i] < b[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Find an n-gram
+ * @return the (log10 prob, log10 backoff) pair, or 0 when not found
+ */
+const float *NgramModel::find( const uint32_t *ids, size_t n ) const {
+  if ( n == 0 || n > order ) {
+    return 0;
+  }
+  const char *table = tables[n - 1];
+  size_t rs = recordSize( n );
+  uint64_t lo = 0;
+  uint64_t hi = counts[n - 1];
+  while ( lo < hi ) {
+    uint64_t mid = lo + ( hi - lo ) / 2;
+    const uint32_t *rec = reinterpret_cast<const uint32_t *>( table + mid * rs );
+    int cmp = compareIds( ids, rec, n );
+    if ( cmp == 0 ) {
+      return reinterpret_cast<const float *>( rec + n );
+    }
+    if ( cmp < 0 ) {
+      hi = mid;
+    }
+    else {
+      lo = mid + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * The log10 probability of the last word of 'ngram', given the others,
+ * backing off to shorter histories the ARPA way.
+ */
+double NgramModel::logprob( const uint32_t *ngram, size_t n ) const {
+  double backoff = 0;
+  for ( size_t s = 0; s < n; ++s ) {
+    const float *rec = find( ngram + s, n - s );
+    if ( rec ) {
+      return backoff + rec[0];
+    }
+    if ( n - s > 1 ) {
+      const float *history = find( ngram + s, n - s - 1 );
+      if ( history ) {
+        backoff += history[1];
+      }
+    }
+  }
+  return NAN;
+}
+
+/**
+ * Score a tokenized sentence, the way Wopr does
+ * @param words      the tokens
+ * @param lprob10    the log10 probability of every token. A token that is
+ *                   not in the vocabulary scores as <unk>, or as the least
+ *                   probable unigram when the model has no <unk>.
+ * @param avg_prob10 the mean log10 probability
+ * @param entropy    the mean number of bits per token
+ * @param perplexity 2^entropy
+ */
+void NgramModel::score( const vector<string>& words,
+                        vector<double>& lprob10,
+                        double& avg_prob10,
+                        double& entropy,
+                        double& perplexity ) const {
+  lprob10.assign( words.size(), NAN );
+  vector<uint32_t> ngram;
+  if ( start != no_word ) {
+    ngram.push_back( start );
+  }
+  double sum = 0;
+  size_t scored = 0;
+  for ( size_t i = 0; i < words.size(); ++i ) {
+    size_t pos = ( backward ? words.size() - 1 - i : i );
+    uint32_t id = wordId( words[pos] );
+    if ( id == no_word ) {
+      id = unk;
+    }
+    if ( ngram.size() >= order ) {
+      ngram.erase( ngram.begin(), ngram.end() - ( order - 1 ) );
+    }
+    ngram.push_back( id );
+    if ( id == no_word ) {
+      lprob10[pos] = oov_prob10;
+    }
+    else {
+      lprob10[pos] = logprob( &ngram[0], ngram.size() );
+    }
+    if ( !std::isnan( lprob10[pos] ) ) {
+      sum += lprob10[pos];
+      ++scored;
+    }
+  }
+  if ( scored == 0 ) {
+    avg_prob10 = NAN;
+    entropy = NAN;
+    perplexity = NAN;
+    return;
+  }
+  avg_prob10 = sum / scored;
+  entropy = -avg_prob10 * log2( 10.0 );
+  perplexity = pow( 2.0, entropy );
+}
+
+/**
+ * Sort the vocabulary (with the unigram values) and number the words
+ * in that order
+ */
+static void numberWords( vector<string>& vocab, vector<float>& probs,
+                         vector<float>& backoffs,
+                         unordered_map<string, uint32_t>& ids ) {
+  vector<size_t> perm( vocab.size() );
+  for ( size_t i = 0; i < perm.size(); ++i ) {
+    perm[i] = i;
+  }
+  sort( perm.begin(), perm.end(),
+        [&vocab]( size_t a, size_t b ) { return vocab[a] < vocab[b]; } );
+  vector<string> sorted_vocab( vocab.size() );
+  vector<float> sorted_probs( vocab.size() );
+  vector<float> sorted_backoffs( vocab.size() );
+  for ( size_t i = 0; i < perm.size(); ++i ) {
+    sorted_vocab[i] = vocab[perm[i]];
+    sorted_probs[i] = probs[perm[i]];
+    sorted_backoffs[i] = backoffs[perm[i]];
+    ids[sorted_vocab[i]] = i;
+  }
+  vocab.swap( sorted_vocab );
+  probs.swap( sorted_probs );
+  backoffs.swap( sorted_backoffs );
+}
+
+/**
+ * Convert an ARPA language model into the binary format
+ * @param arpa    the ARPA file
+ * @param outfile the binary model to write
+ * @param message the reason of failure
+ * @return true on success
+ */
+bool NgramModel::convertArpa( istream& arpa, const string& outfile,
+                              string& message ) {
+  vector<uint64_t> declared;
+  vector<string> vocab;
+  vector<float> unigram_probs;
+  vector<float> unigram_backoffs;
+  unordered_map<string, uint32_t> ids;
+  vector<vector<char>> records;
+  size_t n = 0;
+  string line;
+  size_t line_nr = 0;
+  bool in_data = false;
+  while ( getline( arpa, line ) ) {
+    ++line_nr;
+    if ( !line.empty() && line[line.size() - 1] == '\r' ) {
+      line.resize( line.size() - 1 );
+    }
+    if ( line.empty() ) {
+      continue;
+    }
+    if ( line == "\\data\\" ) {
+      in_data = true;
+      continue;
+    }
+    if ( line == "\\end\\" ) {
+      break;
+    }
+    if ( line[0] == '\\' ) {
+      in_data = false;
+      size_t section = atoi( line.c_str() + 1 );
+      if ( section != n + 1 || section > declared.size()
+           || line.find( "-grams:" ) == string::npos ) {
+        ostringstream os;
+        os << "line " << line_nr << ": unexpected section '" << line << "'";
+        message = os.str();
+        return false;
+      }
+      if ( n == 1 ) {
+        // all words are known now
+        numberWords( vocab, unigram_probs, unigram_backoffs, ids );
+      }
+      n = section;
+      records.resize( n );
+      continue;
+    }
+    if ( in_data ) {
+      size_t eq = line.find( '=' );
+      if ( line.compare( 0, 6, "ngram " ) == 0 && eq != string::npos ) {
+        size_t k = atoi( line.c_str() + 6 );
+        if ( k < 1 || k > max_order ) {
+          message = "only n-grams up to order 8 are supported";
+          return false;
+        }
+        declared.resize( max( declared.size(), k ) );
+        declared[k - 1] = strtoull( line.c_str() + eq + 1, 0, 10 );
+      }
+      continue;
+    }
+    if ( n == 0 ) {
+      continue;
+    }
+    istringstream is( line );
+    float prob;
+    float backoff = 0;
+    vector<string> words( n );
+    is >> prob;
+    for ( size_t i = 0; i < n; ++i ) {
+      is >> words[i];
+    }
+    if ( !is ) {
+      ostringstream os;
+      os << "line " << line_nr << ": invalid " << n << "-gram";
+      message = os.str();
+      return false;
+    }
+    if ( !( is >> backoff ) ) {
+      backoff = 0;
+    }
+    if ( n == 1 ) {
+      vocab.push_back( words[0] );
+      unigram_probs.push_back( prob );
+      unigram_backoffs.push_back( backoff );
+      continue;
+    }
+    vector<char>& table = records[n - 1];
+    size_t offset = table.size();
+    table.resize( offset + recordSize( n ) );
+    uint32_t *rec = reinterpret_cast<uint32_t *>( &table[offset] );
+    for ( size_t i = 0; i < n; ++i ) {
+      auto it = ids.find( words[i] );
+      if ( it == ids.end() ) {
+        ostringstream os;
+        os << "line " << line_nr << ": '" << words[i] << "' is not a 1-gram";
+        message = os.str();
+        return false;
+      }
+      rec[i] = it->second;
+    }
+    float *values = reinterpret_cast<float *>( rec + n );
+    values[0] = prob;
+    values[1] = backoff;
+  }
+  if ( n == 0 || vocab.empty() ) {
+    message = "no n-grams found";
+    return false;
+  }
+  if ( n == 1 ) {
+    numberWords( vocab, unigram_probs, unigram_backoffs, ids );
+  }
+  lm_header h;
+  memset( &h, 0, sizeof( h ) );
+  memcpy( h.magic, lm_magic, sizeof( lm_magic ) );
+  h.order = n;
+  h.vocab_size = vocab.size();
+  vector<uint64_t> offsets( 1, 0 );
+  for ( const auto& w : vocab ) {
+    h.vocab_bytes += w.size();
+    offsets.push_back( h.vocab_bytes );
+  }
+  h.counts[0] = vocab.size();
+  for ( size_t k = 2; k <= n; ++k ) {
+    h.counts[k - 1] = records[k - 1].size() / recordSize( k );
+  }
+  ofstream os( outfile.c_str(), ios::binary );
+  if ( !os ) {
+    message = "unable to write '" + outfile + "'";
+    return false;
+  }
+  os.write( reinterpret_cast<const char *>( &h ), sizeof( h ) );
+  os.write( reinterpret_cast<const char *>( &offsets[0] ),
+            offsets.size() * sizeof( uint64_t ) );
+  for ( const auto& w : vocab ) {
+    os.write( w.data(), w.size() );
+  }
+  size_t written = sizeof( h ) + offsets.size() * sizeof( uint64_t ) + h.vocab_bytes;
+  os.write( "\0\0\0\0\0\0\0", align8( written ) - written );
+  for ( size_t i = 0; i < vocab.size(); ++i ) {
+    uint32_t id = i;
+    os.write( reinterpret_cast<const char *>( &id ), sizeof( id ) );
+    os.write( reinterpret_cast<const char *>( &unigram_probs[i] ), sizeof( float ) );
+    os.write( reinterpret_cast<const char *>( &unigram_backoffs[i] ), sizeof( float ) );
+  }
+  for ( size_t k = 2; k <= n; ++k ) {
+    const vector<char>& table = records[k - 1];
+    size_t rs = recordSize( k );
+    vector<size_t> perm( h.counts[k - 1] );
+    for ( size_t i = 0; i < perm.size(); ++i ) {
+      perm[i] = i;
+    }
+    sort( perm.begin(), perm.end(),
+          [&table, rs, k]( size_t a, size_t b ) {
+            return compareIds( reinterpret_cast<const uint32_t *>( &table[a * rs] ),
+                               reinterpret_cast<const uint32_t *>( &table[b * rs] ),
+                               k ) < 0;
+          } );
+    for ( const auto& i : perm ) {
+      os.write( &table[i * rs], rs );
+    }
+  }
+  if ( !os ) {
+    message = "unable to write '" + outfile + "'";
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <string>
+#include <mutex>
+#include "tscan/overlap.h"
+
+using namespace std;
+
+/**
+ * The pronoun classes of each id, as a bit set (zij/ze are both 3rd person
+ * singular and plural), indexed by the interned id.
+ * Ids after the last pronoun have no class, so the table stays small.
+ * The table is made again when word_ids starts a new generation.
+ */
+static shared_ptr<const vector<unsigned char>> pronoun_classes() {
+  static mutex table_mutex;
+  static shared_ptr<const vector<unsigned char>> table;
+  static uint32_t table_generation = 0;
+  lock_guard<mutex> lock( table_mutex );
+  if ( table && table_generation == word_ids.generation() ) {
+    return table;
+  }
+  const vector<vector<string>> classes = {
+    { "ik", "mij", "me", "mijn" },   // 1st singular
+    { "jij", "je", "jou", "jouw" },  // 2nd singular
+    { "hij", "hem", "zijn" },        // 3rd singular masculine
+    { "zij", "ze", "haar" },         // 3rd singular feminine
+    { "wij", "we", "ons", "onze" },  // 1st plural
+    { "jullie" },                    // 2nd plural
+    { "zij", "ze", "hen", "hun" }    // 3rd plural
+  };
+  vector<unsigned char> *result = new vector<unsigned char>();
+  for ( size_t c = 0; c < classes.size(); ++c ) {
+    for ( const auto& pronoun : classes[c] ) {
+      uint32_t id = word_ids.id( pronoun );
+      if ( id >= result->size() ) {
+        result->resize( id + 1, 0 );
+      }
+      (*result)[id] |= 1 << c;
+    }
+  }
+  table.reset( result );
+  table_generation = word_ids.generation();
+  return table;
+}
+
+unsigned char OverlapWindow::pronoun_class( uint32_t id ) const {
+  return id < pronouns->size() ? (*pronouns)[id] : 0;
+}
+
+OverlapWindow::OverlapWindow( size_t c ):
+  capacity( c ), filled( 0 ), oldest( 0 ), pronouns( pronoun_classes() ) {
+  ring.resize( capacity );
+  fill( class_counts, class_counts + pronoun_class_count, 0 );
+}
+
+void OverlapWindow::count( uint32_t id, int delta ) {
+  id_counts.add( id, delta );
+  unsigned char classes = pronoun_class( id );
+  for ( int c = 0; classes != 0; ++c, classes >>= 1 ) {
+    if ( classes & 1 ) {
+      class_counts[c] += delta;
+    }
+  }
+}
+
+/**
+ * Add an id to the window. When the window is full, the oldest id drops
+ * out.
+ */
+void OverlapWindow::push( uint32_t id ) {
+  count( id, 1 );
+  if ( capacity == 0 ) {
+    ++filled;
+    return;
+  }
+  if ( filled == capacity ) {
+    count( ring[oldest], -1 );
+    ring[oldest] = id;
+    oldest = ( oldest + 1 ) % capacity;
+  }
+  else {
+    ring[( oldest + filled ) % capacity] = id;
+    ++filled;
+  }
+}
+
+/**
+ * Check if a word or lemma overlaps with the window
+ * @param id the interned word or lemma
+ */
+bool OverlapWindow::overlaps( uint32_t id ) const {
+  if ( id_counts.count( id ) > 0 ) {
+    return true;
+  }
+  unsigned char classes = pronoun_class( id );
+  for ( int c = 0; classes != 0; ++c, classes >>= 1 ) {
+    if ( ( classes & 1 ) && class_counts[c] > 0 ) {
+      return true;
+    }
+  }
+  return false;
+}
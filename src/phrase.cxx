@@ -0,0 +1,136 @@
+#include <algorithm>
+#include "tscan/phrase.h"
+
+using namespace std;
+
+/**
+ * Look up the value of a phrase in a lexicon
+ * @param start  the position of the first word
+ * @param length the number of words
+ * @return the value, or -1 when there is no such phrase
+ */
+int PhraseMatches::find( size_t start, size_t length,
+                         Phrase::Lexicon lexicon ) const {
+  if ( start + 1 >= first.size() ) {
+    return -1;
+  }
+  for ( size_t i = first[start]; i < first[start + 1]; ++i ) {
+    if ( matches[i].length == length ) {
+      return matches[i].values[lexicon];
+    }
+  }
+  return -1;
+}
+
+/**
+ * Find the shortest phrase of a lexicon that starts at a position
+ * @param start      the position of the first word
+ * @param max_length the maximum number of words
+ * @param length     the number of words of the phrase found
+ * @return the value, or -1 when there is no such phrase
+ */
+int PhraseMatches::shortest( size_t start, size_t max_length,
+                             Phrase::Lexicon lexicon, size_t& length ) const {
+  if ( start + 1 >= first.size() ) {
+    return -1;
+  }
+  for ( size_t i = first[start]; i < first[start + 1]; ++i ) {
+    if ( matches[i].length > max_length ) {
+      break;
+    }
+    if ( matches[i].values[lexicon] >= 0 ) {
+      length = matches[i].length;
+      return matches[i].values[lexicon];
+    }
+  }
+  return -1;
+}
+
+PhraseTrie::Node::Node(): terminal( false ) {
+  fill( values, values + Phrase::LEXICON_COUNT, -1 );
+}
+
+PhraseTrie::PhraseTrie(): nodes( 1 ) {
+}
+
+uint32_t PhraseTrie::child( uint32_t node, uint32_t token ) const {
+  const auto& children = nodes[node].children;
+  auto it = lower_bound( children.begin(), children.end(),
+                         make_pair( token, uint32_t( 0 ) ) );
+  if ( it == children.end() || it->first != token ) {
+    return 0;
+  }
+  return it->second;
+}
+
+/**
+ * Add a phrase of two or more words, separated by single spaces.
+ * Single words are left to the word lists.
+ */
+void PhraseTrie::add( const string& phrase, Phrase::Lexicon lexicon,
+                      int value ) {
+  if ( phrase.find( ' ' ) == string::npos ) {
+    return;
+  }
+  uint32_t node = 0;
+  size_t start = 0;
+  while ( start <= phrase.size() ) {
+    size_t end = phrase.find( ' ', start );
+    if ( end == string::npos ) {
+      end = phrase.size();
+    }
+    auto id = vocabulary.insert( make_pair( phrase.substr( start, end - start ),
+                                            uint32_t( vocabulary.size() ) ) );
+    uint32_t token = id.first->second;
+    uint32_t next = child( node, token );
+    if ( next == 0 ) {
+      next = nodes.size();
+      auto& children = nodes[node].children;
+      children.insert( lower_bound( children.begin(), children.end(),
+                                    make_pair( token, uint32_t( 0 ) ) ),
+                       make_pair( token, next ) );
+      nodes.push_back( Node() );
+    }
+    node = next;
+    start = end + 1;
+  }
+  nodes[node].terminal = true;
+  if ( nodes[node].values[lexicon] < 0 ) {
+    nodes[node].values[lexicon] = value;
+  }
+}
+
+/**
+ * Find all phrases in a sentence
+ * @param tokens  the words (or lemmas) of the sentence
+ * @param result  all phrases, by start position and length
+ */
+void PhraseTrie::match( const vector<string>& tokens,
+                        PhraseMatches& result ) const {
+  const uint32_t unknown = uint32_t( -1 );
+  vector<uint32_t> ids( tokens.size(), unknown );
+  for ( size_t i = 0; i < tokens.size(); ++i ) {
+    auto it = vocabulary.find( tokens[i] );
+    if ( it != vocabulary.end() ) {
+      ids[i] = it->second;
+    }
+  }
+  result.matches.clear();
+  result.first.assign( 1, 0 );
+  for ( size_t i = 0; i < ids.size(); ++i ) {
+    uint32_t node = 0;
+    for ( size_t j = i; j < ids.size() && ids[j] != unknown; ++j ) {
+      node = child( node, ids[j] );
+      if ( node == 0 ) {
+        break;
+      }
+      if ( nodes[node].terminal ) {
+        PhraseMatches::Match m;
+        m.length = j - i + 1;
+        m.values = nodes[node].values;
+        result.matches.push_back( m );
+      }
+    }
+    result.first.push_back( result.matches.size() );
+  }
+}
@@ -12,7 +12,7 @@ void sentStats::setCommonCounts(wordStats *ws) {
   switch (ws->prop) {
     case CGN::ISNAME:
       nameInclCnt++;
-      unique_names[ws->l_word] += 1;
+      unique_names.add( ws->l_word.id() );
       break;
     case CGN::ISVD:
       switch (ws->position) {
@@ -133,19 +133,19 @@ void sentStats::setCommonCounts(wordStats *ws) {
   if (ws->archaic) archaicsCnt++;
   if (ws->isImperative) impCnt++;
 
-  unique_words[ws->l_word] += 1;
-  unique_lemmas[ws->lemma] += 1;
+  unique_words.add( ws->l_word.id() );
+  unique_lemmas.add( ws->lemma.id() );
 
   wordOverlapCnt += ws->wordOverlapCnt;
   lemmaOverlapCnt += ws->lemmaOverlapCnt;
 
   if (ws->isContent) {
     contentInclCnt++;
-    unique_contents[ws->l_word] += 1;
+    unique_contents.add( ws->l_word.id() );
   }
   if (ws->isContentStrict) {
     contentStrictInclCnt++;
-    unique_contents_strict[ws->l_word] += 1;
+    unique_contents_strict.add( ws->l_word.id() );
   }
 
   // Counts for abbreviations
@@ -242,45 +242,25 @@ void sentStats::setFormalCounts(wordStats *ws) {
  ****/
 
 double sentStats::getMeanAL() const {
-  double result = NAN;
-  size_t len = distances.size();
-  if ( len > 0 ) {
-    result = 0;
-    for ( multimap<DD_type, int>::const_iterator pos = distances.begin(); pos != distances.end(); ++pos ) {
-      result += pos->second;
-    }
-    result = result / len;
-  }
-  return result;
+  return distances.mean();
 }
 
 double sentStats::getHighestAL() const {
-  double result = 0;
-  for( multimap<DD_type, int>::const_iterator pos = distances.begin(); pos != distances.end(); ++pos ) {
-    if ( pos->second > result )
-      result = pos->second;
-  }
-  return result;
+  return distances.highest();
 }
 
 /*************
  * CONNECTIVES
  *************/
 
-void sentStats::resolveConnectives() {
-  const string neg_longA[] = { "afgezien van", "zomin als", "met uitzondering van"};
-  static set<string> negatives_long = set<string>( neg_longA, neg_longA + sizeof(neg_longA)/sizeof(string) );
-
+void sentStats::resolveConnectives( const PhraseMatches &phrases ) {
   if ( sv.size() > 1 ){
     for ( size_t i=0; i < sv.size()-2; ++i ){
-      string word = sv[i]->ltext();
-      string multiword2 = word + " " + sv[i+1]->ltext();
       if ( !checkAls( i ) ){
 	// "als" is speciaal als het matcht met eerdere woorden.
 	// (evenmin ... als) (zowel ... als ) etc.
 	// In dat geval niet meer zoeken naar "als ..."
-	//      cerr << "zoek op " << multiword2 << endl;
-	Conn::Type conn = checkMultiConnectives( multiword2 );
+	Conn::Type conn = checkMultiConnectives( phrases, i, 2 );
 	if ( conn != Conn::NOCONN ){
 	  sv[i]->setMultiConn();
 	  sv[i+1]->setMultiConn();
@@ -288,12 +268,10 @@ void sentStats::resolveConnectives() {
 	  sv[i+1]->setConnType( Conn::NOCONN );
 	}
       }
-      if ( negatives_long.find( multiword2 ) != negatives_long.end() ){
+      if ( phrases.find( i, 2, Phrase::NEGATIVE ) >= 0 ){
 	propNegCnt++;
       }
-      string multiword3 = multiword2 + " " + sv[i+2]->ltext();
-      //      cerr << "zoek op " << multiword3 << endl;
-      Conn::Type conn = checkMultiConnectives( multiword3 );
+      Conn::Type conn = checkMultiConnectives( phrases, i, 3 );
       if ( conn != Conn::NOCONN ){
 	sv[i]->setMultiConn();
 	sv[i+1]->setMultiConn();
@@ -302,58 +280,55 @@ void sentStats::resolveConnectives() {
 	sv[i+1]->setConnType( Conn::NOCONN );
 	sv[i+2]->setConnType( Conn::NOCONN );
       }
-      if ( negatives_long.find( multiword3 ) != negatives_long.end() )
+      if ( phrases.find( i, 3, Phrase::NEGATIVE ) >= 0 )
 	propNegCnt++;
     }
     // don't forget the last 2 words
-    string multiword2 = sv[sv.size()-2]->ltext() + " "
-      + sv[sv.size()-1]->ltext();
-    //    cerr << "zoek op " << multiword2 << endl;
-    Conn::Type conn = checkMultiConnectives( multiword2 );
+    Conn::Type conn = checkMultiConnectives( phrases, sv.size()-2, 2 );
     if ( conn != Conn::NOCONN ){
       sv[sv.size()-2]->setMultiConn();
       sv[sv.size()-1]->setMultiConn();
       sv[sv.size()-2]->setConnType( conn );
       sv[sv.size()-1]->setConnType( Conn::NOCONN );
     }
-    if ( negatives_long.find( multiword2 ) != negatives_long.end() ){
+    if ( phrases.find( sv.size()-2, 2, Phrase::NEGATIVE ) >= 0 ){
       propNegCnt++;
     }
   }
   for ( size_t i=0; i < sv.size(); ++i ){
     switch( sv[i]->getConnType() ){
     case Conn::TEMPOREEL:
-      unique_temp_conn[sv[i]->ltext()]++;
-      unique_all_conn[sv[i]->ltext()]++;
+      unique_temp_conn.add( sv[i]->ltextId() );
+      unique_all_conn.add( sv[i]->ltextId() );
       tempConnCnt++;
       allConnCnt++;
       break;
     case Conn::OPSOMMEND_WG:
-      unique_reeks_wg_conn[sv[i]->ltext()]++;
+      unique_reeks_wg_conn.add( sv[i]->ltextId() );
       opsomWgConnCnt++;
       // Don't add OPSOMMEND_WG to allContCnt/unique_all_conn
       break;
     case Conn::OPSOMMEND_ZIN:
-      unique_reeks_zin_conn[sv[i]->ltext()]++;
-      unique_all_conn[sv[i]->ltext()]++;
+      unique_reeks_zin_conn.add( sv[i]->ltextId() );
+      unique_all_conn.add( sv[i]->ltextId() );
       opsomZinConnCnt++;
       allConnCnt++;
       break;
     case Conn::CONTRASTIEF:
-      unique_contr_conn[sv[i]->ltext()]++;
-      unique_all_conn[sv[i]->ltext()]++;
+      unique_contr_conn.add( sv[i]->ltextId() );
+      unique_all_conn.add( sv[i]->ltextId() );
       contrastConnCnt++;
       allConnCnt++;
       break;
     case Conn::COMPARATIEF:
-      unique_comp_conn[sv[i]->ltext()]++;
-      unique_all_conn[sv[i]->ltext()]++;
+      unique_comp_conn.add( sv[i]->ltextId() );
+      unique_all_conn.add( sv[i]->ltextId() );
       compConnCnt++;
       allConnCnt++;
       break;
     case Conn::CAUSAAL:
-      unique_cause_conn[sv[i]->ltext()]++;
-      unique_all_conn[sv[i]->ltext()]++;
+      unique_cause_conn.add( sv[i]->ltextId() );
+      unique_all_conn.add( sv[i]->ltextId() );
       causeConnCnt++;
       allConnCnt++;
       break;
@@ -427,17 +402,11 @@ bool sentStats::checkAls( size_t index ) {
  * SITUATIONS
  ************/
 
-void sentStats::resolveSituations() {
+void sentStats::resolveSituations( const PhraseMatches &phrases ) {
   if ( sv.size() > 1 ){
     for ( size_t i=0; (i+3) < sv.size(); ++i ){
-      string word = sv[i]->Lemma();
-      string multiword2 = word + " " + sv[i+1]->Lemma();
-      string multiword3 = multiword2 + " " + sv[i+2]->Lemma();
-      string multiword4 = multiword3 + " " + sv[i+3]->Lemma();
-      //      cerr << "zoek 4 op '" << multiword4 << "'" << endl;
-      Situation::Type sit = checkMultiSituations( multiword4 );
+      Situation::Type sit = checkMultiSituations( phrases, i, 4 );
       if ( sit != Situation::NO_SIT ){
-        // cerr << "found " << sit << "-situation: " << multiword4 << endl;
         sv[i]->setSitType( Situation::NO_SIT );
         sv[i + 1]->setSitType( Situation::NO_SIT );
         sv[i + 2]->setSitType( Situation::NO_SIT );
@@ -445,20 +414,16 @@ void sentStats::resolveSituations() {
         i += 3;
       }
       else {
-        // cerr << "zoek 3 op '" << multiword3 << "'" << endl;
-        sit = checkMultiSituations( multiword3 );
+        sit = checkMultiSituations( phrases, i, 3 );
         if ( sit != Situation::NO_SIT ) {
-          // cerr << "found " << sit << "-situation: " << multiword3 << endl;
           sv[i]->setSitType( Situation::NO_SIT );
           sv[i + 1]->setSitType( Situation::NO_SIT );
           sv[i + 2]->setSitType( sit );
           i += 2;
         }
         else {
-          // cerr << "zoek 2 op '" << multiword2 << "'" << endl;
-          sit = checkMultiSituations( multiword2 );
+          sit = checkMultiSituations( phrases, i, 2 );
           if ( sit != Situation::NO_SIT ) {
-            //	    cerr << "found " << sit << "-situation: " << multiword2 << endl;
             sv[i]->setSitType( Situation::NO_SIT );
             sv[i + 1]->setSitType( sit );
             i += 1;
@@ -469,31 +434,21 @@ void sentStats::resolveSituations() {
     // don't forget the last 2 and 3 words
     Situation::Type sit = Situation::NO_SIT;
     if ( sv.size() > 2 ){
-      string multiword3 = sv[sv.size() - 3]->Lemma() + " "
-                   + sv[sv.size() - 2]->Lemma() + " " + sv[sv.size() - 1]->Lemma();
-      // cerr << "zoek final 3 op '" << multiword3 << "'" << endl;
-      sit = checkMultiSituations( multiword3 );
+      sit = checkMultiSituations( phrases, sv.size() - 3, 3 );
       if ( sit != Situation::NO_SIT ) {
-        //	cerr << "found " << sit << "-situation: " << multiword3 << endl;
         sv[sv.size() - 3]->setSitType( Situation::NO_SIT );
         sv[sv.size() - 2]->setSitType( Situation::NO_SIT );
         sv[sv.size() - 1]->setSitType( sit );
       }
       else {
-        string multiword2 = sv[sv.size() - 3]->Lemma() + " " + sv[sv.size() - 2]->Lemma();
-        // cerr << "zoek first final 2 op '" << multiword2 << "'" << endl;
-        sit = checkMultiSituations( multiword2 );
+        sit = checkMultiSituations( phrases, sv.size() - 3, 2 );
         if ( sit != Situation::NO_SIT ) {
-          //	  cerr << "found " << sit << "-situation: " << multiword2 << endl;
           sv[sv.size() - 3]->setSitType( Situation::NO_SIT );
           sv[sv.size() - 2]->setSitType( sit );
         }
         else {
-          multiword2 = sv[sv.size() - 2]->Lemma() + " " + sv[sv.size() - 1]->Lemma();
-          // cerr << "zoek second final 2 op '" << multiword2 << "'" << endl;
-          sit = checkMultiSituations( multiword2 );
+          sit = checkMultiSituations( phrases, sv.size() - 2, 2 );
           if ( sit != Situation::NO_SIT ) {
-            //	    cerr << "found " << sit << "-situation: " << multiword2 << endl;
             sv[sv.size() - 2]->setSitType( Situation::NO_SIT );
             sv[sv.size() - 1]->setSitType( sit );
           }
@@ -501,12 +456,8 @@ void sentStats::resolveSituations() {
       }
     }
     else {
-      string multiword2 = sv[sv.size() - 2]->Lemma() + " "
-                   + sv[sv.size() - 1]->Lemma();
-      // cerr << "zoek second final 2 op '" << multiword2 << "'" << endl;
-      sit = checkMultiSituations( multiword2 );
+      sit = checkMultiSituations( phrases, sv.size() - 2, 2 );
       if ( sit != Situation::NO_SIT ){
-        // cerr << "found " << sit << "-situation: " << multiword2 << endl;
         sv[sv.size() - 2]->setSitType( Situation::NO_SIT );
         sv[sv.size() - 1]->setSitType( sit );
       }
@@ -515,19 +466,19 @@ void sentStats::resolveSituations() {
   for ( size_t i=0; i < sv.size(); ++i ){
     switch( sv[i]->getSitType() ){
     case Situation::TIME_SIT:
-      unique_tijd_sits[sv[i]->Lemma()]++;
+      unique_tijd_sits.add( sv[i]->lemmaId() );
       timeSitCnt++;
       break;
     case Situation::CAUSAL_SIT:
-      unique_cause_sits[sv[i]->Lemma()]++;
+      unique_cause_sits.add( sv[i]->lemmaId() );
       causeSitCnt++;
       break;
     case Situation::SPACE_SIT:
-      unique_ruimte_sits[sv[i]->Lemma()]++;
+      unique_ruimte_sits.add( sv[i]->lemmaId() );
       spaceSitCnt++;
       break;
     case Situation::EMO_SIT:
-      unique_emotion_sits[sv[i]->Lemma()]++;
+      unique_emotion_sits.add( sv[i]->lemmaId() );
       emoSitCnt++;
       break;
     default:
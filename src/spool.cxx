@@ -0,0 +1,71 @@
+#include <cstdio>
+#include "tscan/spool.h"
+
+using namespace std;
+
+spoolFile::spoolFile():
+  file( tmpfile() ), bytes( 0 ), failed( false ) {
+}
+
+spoolFile::~spoolFile() {
+  if ( file ) {
+    fclose( file );
+  }
+}
+
+void spoolFile::write( const string& text ) {
+  if ( !good() ) {
+    return;
+  }
+  if ( fwrite( text.data(), 1, text.size(), file ) != text.size() ) {
+    failed = true;
+  }
+  bytes += text.size();
+}
+
+/**
+ * Go back to the start, to read what was written
+ */
+void spoolFile::rewind() {
+  if ( file ) {
+    fflush( file );
+    std::rewind( file );
+  }
+}
+
+/**
+ * Read a line
+ * @param line the line, with its newline
+ * @return false at the end of the file
+ */
+bool spoolFile::getline( string& line ) {
+  line.clear();
+  if ( !good() ) {
+    return false;
+  }
+  int c;
+  while ( ( c = getc( file ) ) != EOF ) {
+    line += static_cast<char>( c );
+    if ( c == '\n' ) {
+      break;
+    }
+  }
+  return !line.empty();
+}
+
+/**
+ * Copy the rest of the file
+ * @param os the output
+ * @return true when all could be read and written
+ */
+bool spoolFile::copy( ostream& os ) {
+  if ( !good() ) {
+    return false;
+  }
+  char buf[65536];
+  size_t n;
+  while ( ( n = fread( buf, 1, sizeof( buf ), file ) ) > 0 ) {
+    os.write( buf, n );
+  }
+  return !ferror( file ) && static_cast<bool>( os );
+}
@@ -2,23 +2,26 @@
 
 using namespace std;
 
-structStats::~structStats(){
-  vector<basicStats *>::iterator it = sv.begin();
-  while ( it != sv.end() ){
-    delete( *it );
-    ++it;
-  }
+/**
+ * The words of this structure, without copying them
+ */
+word_range structStats::words() const {
+  if ( !all_words || first_word == last_word )
+    return word_range();
+  const wordStats *const *base = all_words->data();
+  return word_range( base + first_word, base + last_word );
 }
 
-vector<const wordStats*> structStats::collectWords() const {
-  vector<const wordStats*> result;
-  vector<basicStats *>::const_iterator it = sv.begin();
-  while ( it != sv.end() ){
-    vector<const wordStats*> tmp = (*it)->collectWords();
-    result.insert( result.end(), tmp.begin(), tmp.end() );
-    ++it;
-  }
-  return result;
+/**
+ * Make the words from 'first' to the end of the index the words of this
+ * structure
+ * @param index the word index of the document
+ * @param first the position of the first word
+ */
+void structStats::setWordRange( const word_index& index, size_t first ){
+  all_words = &index;
+  first_word = first;
+  last_word = index.size();
 }
 
 /****
@@ -26,31 +29,17 @@ vector<const wordStats*> structStats::collectWords() const {
  ****/
 
 double structStats::getMeanAL() const {
-  double sum = 0;
-  for ( size_t i=0; i < sv.size(); ++i ){
-    double val = sv[i]->get_al_gem();
-    if ( !std::isnan(val) ){
-      sum += val;
-    }
-  }
-  if ( sum == 0 )
+  if ( al_gem_sum == 0 )
     return NAN;
   else
-    return sum/sv.size();
+    return al_gem_sum/al_count;
 }
 
 double structStats::getHighestAL() const {
-  double sum = 0;
-  for ( size_t i=0; i < sv.size(); ++i ){
-    double val = sv[i]->get_al_max();
-    if ( !std::isnan(val) ){
-      sum += val;
-    }
-  }
-  if ( sum == 0 )
+  if ( al_max_sum == 0 )
     return NAN;
   else
-    return sum/sv.size();
+    return al_max_sum/al_count;
 }
 
 /************
@@ -62,7 +51,7 @@ double structStats::getHighestAL() const {
  * @param os    the current outputstream
  * @param intro specific columns per struct (document, paragraph, sentence)
  */
-void structStats::CSVheader( ostream& os, const string& intro ) const {
+void structStats::CSVheader( csvRow& os, const string& intro ) const {
   os << intro << ",Alpino_status,";
   topPredictorsHeader( os );
   wordDifficultiesHeader( os );
@@ -79,14 +68,14 @@ void structStats::CSVheader( ostream& os, const string& intro ) const {
   intensHeader( os );
   formalHeader( os );
   miscHeader( os );
-  os << endl;
+  os << "\n";
 }
 
 /**
  * Sets all .csv-output for structStats.
  * @param os the current outputstream
  */
-void structStats::toCSV( ostream& os ) const {
+void structStats::toCSV( csvRow& os ) const {
   if (!isSentence())
   {
     // For paragraphs and documents, add a sentence and word count.
@@ -96,7 +85,7 @@ void structStats::toCSV( ostream& os ) const {
   else
   {
     // For sentences, add the original sentence (quoted)
-    os << "\"" << escape_quotes(text) << "\",";
+    os << csvQuoted( text ) << ",";
   }
 
   os << parseFailCnt << ","; // Alpino_status
@@ -117,10 +106,10 @@ void structStats::toCSV( ostream& os ) const {
   formalToCSV( os );
   miscToCSV( os );
 
-  os << endl;
+  os << "\n";
 }
 
-void structStats::topPredictorsHeader( ostream& os ) const { 
+void structStats::topPredictorsHeader( csvRow& os ) const { 
   os << "wrd_freq_log_zn_corr,wrd_freq_zn_log,"
      << "Conc_nw_ruim_p,Conc_nw_strikt_p," 
      << "Alg_nw_d,"
@@ -136,7 +125,7 @@ void structStats::topPredictorsHeader( ostream& os ) const {
      << "MTLD_inhwrd_zonder_abw,";
 }
 
-void structStats::topPredictorsToCSV( ostream& os ) const { 
+void structStats::topPredictorsToCSV( csvRow& os ) const { 
   os << proportion(word_freq_log_n_corr, contentCnt-nameCnt) << ","; //wrd_freq_log_zn_corr
   os << word_freq_log_n << ","; //wrd_freq_zn_log
 
@@ -150,7 +139,7 @@ void structStats::topPredictorsToCSV( ostream& os ) const {
   os << proportion( wordInclCnt, sentCnt ) << ","; //Wrd_per_zin
   os << proportion( wordInclCnt, correctedClauseCnt ) << ","; //Wrd_per_dz
   os << proportion( contentStrictInclCnt, correctedClauseCnt ) << ",";  //Inhwrd_dz_zonder_abw
-  os << toMString( al_max ) << ","; //AL_max
+  os << csvNumber( al_max ) << ","; //AL_max
 
   double bijzinCnt = betrCnt + bijwCnt + complCnt;
   os << proportion( bijzinCnt + infinComplBepCnt, sentCnt ) << ","; //Bijzin_per_zin
@@ -162,7 +151,7 @@ void structStats::topPredictorsToCSV( ostream& os ) const {
   os << content_mtld_strict << ","; //MTLD_inhwrd_zonder_abw
 }
 
-void structStats::wordDifficultiesHeader( ostream& os ) const {
+void structStats::wordDifficultiesHeader( csvRow& os ) const {
   os << "Let_per_wrd,Wrd_per_let,Let_per_wrd_zn,Wrd_per_let_zn,"
      << "Morf_per_wrd,Wrd_per_morf,Morf_per_wrd_zn,Wrd_per_morf_zn,"
      << "Namen_p,Namen_d,"
@@ -178,7 +167,7 @@ void structStats::wordDifficultiesHeader( ostream& os ) const {
      << "Freq5000_inhwrd_zonder_abw,Freq10000_inhwrd_zonder_abw,Freq20000_inhwrd_zonder_abw,";
 }
 
-void structStats::wordDifficultiesToCSV( ostream& os ) const {
+void structStats::wordDifficultiesToCSV( csvRow& os ) const {
   os << std::showpoint
      << proportion( charCnt, wordCnt ) << ","
      << proportion( wordCnt, charCnt ) <<  ","
@@ -234,7 +223,7 @@ void structStats::wordDifficultiesToCSV( ostream& os ) const {
   os << proportion( top20000ContentStrictCnt, contentStrictCnt ) << ",";
 }
 
-void structStats::compoundHeader( ostream& os ) const {
+void structStats::compoundHeader( csvRow& os ) const {
   os << "Samenst_d,Samenst_p,Samenst3_d,Samenst3_p,";
   os << "Let_per_wrd_nw,Let_per_wrd_nsam,Let_per_wrd_sam,";
   os << "Let_per_wrd_hfdwrd,Let_per_wrd_satwrd,";
@@ -253,7 +242,7 @@ void structStats::compoundHeader( ostream& os ) const {
   os << "Freq1000_corr,Freq5000_corr,Freq20000_corr,";
 }
 
-void structStats::compoundToCSV( ostream& os ) const {
+void structStats::compoundToCSV( csvRow& os ) const {
   int nonCompoundCnt = nounCnt - compoundCnt;
   os << density(compoundCnt, wordCnt) << ",";
   os << proportion(compoundCnt, nounCnt) << ",";
@@ -301,7 +290,7 @@ void structStats::compoundToCSV( ostream& os ) const {
   os << proportion(top20000CntCorr, wordCnt) << ",";
 }
 
-void structStats::sentDifficultiesHeader( ostream& os ) const {
+void structStats::sentDifficultiesHeader( csvRow& os ) const {
   os << "Zin_per_wrd,Dzin_per_wrd,"
      << "Wrd_per_nwg,"
      << "Betr_bijzin_per_zin,Bijw_bijzin_per_zin,"
@@ -330,7 +319,7 @@ void structStats::sentDifficultiesHeader( ostream& os ) const {
      << "AL_gem,";
 }
 
-void structStats::sentDifficultiesToCSV( ostream& os ) const {
+void structStats::sentDifficultiesToCSV( csvRow& os ) const {
   os << proportion( sentCnt, wordInclCnt )  << ","; //Zin_per_wrd
   os << proportion( correctedClauseCnt, wordInclCnt )  << ","; //Dzin_per_wrd
   if ( isSentence() && parseFailCnt > 0 ) {
@@ -388,27 +377,27 @@ void structStats::sentDifficultiesToCSV( ostream& os ) const {
   os << proportion( propNegCnt+morphNegCnt, correctedClauseCnt ) << ",";
   os << density( multiNegCnt, wordInclCnt ) << ",";
   os << proportion( multiNegCnt, correctedClauseCnt ) << ",";
-  os << MMtoString( distances, SUB_VERB ) << ",";
-  os << MMtoString( distances, OBJ1_VERB ) << ",";
-  os << MMtoString( distances, OBJ2_VERB ) << ",";
-  os << MMtoString( distances, VERB_PP ) << ",";
-  os << MMtoString( distances, NOUN_DET ) << ",";
-  os << MMtoString( distances, PREP_OBJ1 ) << ",";
-  os << MMtoString( distances, VERB_VC ) << ",";
-  os << MMtoString( distances, COMP_BODY ) << ",";
-  os << MMtoString( distances, CRD_CNJ ) << ",";
-  os << MMtoString( distances, VERB_COMP ) << ",";
-  os << MMtoString( distances, NOUN_VC ) << ",";
-  os << MMtoString( distances, VERB_SVP ) << ",";
-  os << MMtoString( distances, VERB_PREDC_N ) << ",";
-  os << MMtoString( distances, VERB_PREDC_A ) << ",";
-  os << MMtoString( distances, VERB_MOD_A ) << ",";
-  os << MMtoString( distances, VERB_MOD_BW ) << ",";
-  os << MMtoString( distances, VERB_NOUN ) << ",";
-  os << toMString( al_gem ) << ",";
+  os << distances.mean( SUB_VERB ) << ",";
+  os << distances.mean( OBJ1_VERB ) << ",";
+  os << distances.mean( OBJ2_VERB ) << ",";
+  os << distances.mean( VERB_PP ) << ",";
+  os << distances.mean( NOUN_DET ) << ",";
+  os << distances.mean( PREP_OBJ1 ) << ",";
+  os << distances.mean( VERB_VC ) << ",";
+  os << distances.mean( COMP_BODY ) << ",";
+  os << distances.mean( CRD_CNJ ) << ",";
+  os << distances.mean( VERB_COMP ) << ",";
+  os << distances.mean( NOUN_VC ) << ",";
+  os << distances.mean( VERB_SVP ) << ",";
+  os << distances.mean( VERB_PREDC_N ) << ",";
+  os << distances.mean( VERB_PREDC_A ) << ",";
+  os << distances.mean( VERB_MOD_A ) << ",";
+  os << distances.mean( VERB_MOD_BW ) << ",";
+  os << distances.mean( VERB_NOUN ) << ",";
+  os << csvNumber( al_gem ) << ",";
 }
 
-void structStats::infoHeader( ostream& os ) const {
+void structStats::infoHeader( csvRow& os ) const {
   os << "Bijw_bep_d,Bijw_bep_dz,Bijw_bep_dz_zbijzin,"
      << "Bijw_bep_alg_d,Bijw_bep_alg_dz,"
      << "Bijv_bep_d,Bijv_bep_dz,"
@@ -430,7 +419,7 @@ void structStats::infoHeader( ostream& os ) const {
      << "Onbep_nwg_p,Onbep_nwg_dz,";
 }
 
-void structStats::informationDensityToCSV( ostream& os ) const {
+void structStats::informationDensityToCSV( csvRow& os ) const {
   os << density( vcModCnt, wordInclCnt ) << ","; //Bijw_bep_d
   os << proportion( vcModCnt, correctedClauseCnt ) << ","; //Bijw_bep_dz
 
@@ -517,7 +506,7 @@ void structStats::informationDensityToCSV( ostream& os ) const {
   os << proportion( indefNpCnt, correctedClauseCnt ) << ",";
 }
 
-void structStats::coherenceHeader( ostream& os ) const {
+void structStats::coherenceHeader( csvRow& os ) const {
   os << "Conn_d,Conn_dz,Conn_TTR,Conn_MTLD,"
      << "Conn_temp_d,Conn_temp_dz,Conn_temp_TTR,Conn_temp_MTLD,"
      << "Conn_reeks_wg_d,Conn_reeks_wg_dz,Conn_reeks_wg_TTR,Conn_reeks_wg_MTLD,"
@@ -532,7 +521,7 @@ void structStats::coherenceHeader( ostream& os ) const {
      << "Emotie_TTR,Emotie_MTLD,";
 }
 
-void structStats::coherenceToCSV( ostream& os ) const {
+void structStats::coherenceToCSV( csvRow& os ) const {
   os << density( allConnCnt, wordInclCnt ) << ",";
   os << proportion( allConnCnt, correctedClauseCnt ) << ",";
   os << proportion( unique_all_conn.size(), allConnCnt ) << ",";
@@ -576,7 +565,7 @@ void structStats::coherenceToCSV( ostream& os ) const {
   os << emotion_sit_mtld << ",";
 }
 
-void structStats::concreetHeader( ostream& os ) const {
+void structStats::concreetHeader( csvRow& os ) const {
   os << "Conc_nw_strikt_d,";
   os << "Conc_nw_ruim_d,";
   os << "Pers_nw_p,Pers_nw_d,";
@@ -647,7 +636,7 @@ void structStats::concreetHeader( ostream& os ) const {
   os << "Gedekte_bw_p,";
 }
 
-void structStats::concreetToCSV( ostream& os ) const {
+void structStats::concreetToCSV( csvRow& os ) const {
   int coveredNouns = nounCnt+nameCnt-uncoveredNounCnt;
   os << density( strictNounCnt, wordCnt ) << ","; // column: Conc_nw_strikt_d
   os << density( broadNounCnt, wordCnt ) << ","; // column: Conc_nw_ruim_d
@@ -787,13 +776,13 @@ void structStats::concreetToCSV( ostream& os ) const {
   os << proportion( coveredAdverbs, bwCnt ) << ",";
 }
 
-void structStats::persoonlijkheidHeader( ostream& os ) const {
+void structStats::persoonlijkheidHeader( csvRow& os ) const {
   os << "Pers_vnw1_d,Pers_vnw2_d,Pers_vnw3_d,"
      << "Pers_namen_p, Pers_namen_p2, Pers_namen_d, Plaatsnamen_d,"
      << "Org_namen_d, Prod_namen_d, Event_namen_d,";
 }
 
-void structStats::persoonlijkheidToCSV( ostream& os ) const {
+void structStats::persoonlijkheidToCSV( csvRow& os ) const {
   os << density( pron1Cnt, wordInclCnt ) << ","; // column: Pers_vnw1_d
   os << density( pron2Cnt, wordInclCnt ) << ","; // column: Pers_vnw2_d
   os << density( pron3Cnt, wordInclCnt ) << ","; // column: Pers_vnw3_d
@@ -812,7 +801,7 @@ void structStats::persoonlijkheidToCSV( ostream& os ) const {
   os << density( val, wordCnt ) << ",";
 }
 
-void structStats::verbHeader( ostream& os ) const {
+void structStats::verbHeader( csvRow& os ) const {
   os << "Actieww_p,Actieww_d,Toestww_p,Toestww_d,"
      << "Procesww_p,Procesww_d,Undefined_ATP_ww_p,"
      << "Ww_tt_p,Ww_tt_dz,Ww_mod_d_,Ww_mod_dz,"
@@ -828,7 +817,7 @@ void structStats::verbHeader( ostream& os ) const {
      << "Ovd_vrij_d,Ovd_vrij_dz,";
 }
 
-void structStats::verbToCSV( ostream& os ) const {
+void structStats::verbToCSV( csvRow& os ) const {
   os << proportion( actionCnt, verbCnt ) << ",";
   os << density( actionCnt, wordCnt) << ",";
   os << proportion( stateCnt, verbCnt ) << ",";
@@ -868,26 +857,26 @@ void structStats::verbToCSV( ostream& os ) const {
   os << proportion( odVrijCnt, correctedClauseCnt ) << ",";
 }
 
-void structStats::imperativeHeader( ostream& os ) const {
+void structStats::imperativeHeader( csvRow& os ) const {
   os << "Imp_ellips_p,Imp_ellips_d," // 20141003: Features renamed
      << "Vragen_p,Vragen_d,";
 }
 
-void structStats::imperativeToCSV( ostream& os ) const {
+void structStats::imperativeToCSV( csvRow& os ) const {
   os << proportion( impCnt, sentCnt ) << ",";
   os << density( impCnt, wordInclCnt ) << ",";
   os << proportion( questCnt, sentCnt ) << ",";
   os << density( questCnt, wordInclCnt ) << ",";
 }
 
-void structStats::wordSortHeader( ostream& os ) const {
+void structStats::wordSortHeader( csvRow& os ) const {
   os << "Bvnw_d,Vg_d,Vnw_d,Lidw_d,Vz_d,Bijw_d,Tw_d,Nw_d,Ww_d,Tuss_d,Spec_d,"
      << "Interp_d,"
      << "Afk_d,Afk_gen_d,Afk_int_d,Afk_jur_d,Afk_med_d,"
      << "Afk_ond_d,Afk_pol_d,Afk_ov_d,Afk_zorg_d,";
 }
 
-void structStats::wordSortToCSV( ostream& os ) const {
+void structStats::wordSortToCSV( csvRow& os ) const {
   os << density(adjInclCnt, wordInclCnt ) << ","
      << density(vgCnt, wordInclCnt ) << ","
      << density(vnwCnt, wordInclCnt ) << ","
@@ -919,23 +908,23 @@ void structStats::wordSortToCSV( ostream& os ) const {
      << density( zorga, wordInclCnt ) << ",";
 }
 
-void structStats::prepPhraseHeader( ostream& os ) const {
+void structStats::prepPhraseHeader( csvRow& os ) const {
   os << "Vzu_d,Vzu_dz,Arch_d,";
 }
 
-void structStats::prepPhraseToCSV( ostream& os ) const {
+void structStats::prepPhraseToCSV( csvRow& os ) const {
   os << density( prepExprCnt, wordInclCnt ) << ",";
   os << proportion( prepExprCnt, correctedClauseCnt ) << ",";
   os << density( archaicsCnt, wordInclCnt ) << ",";
 }
 
-void structStats::intensHeader( ostream& os ) const {
+void structStats::intensHeader( csvRow& os ) const {
   os << "Int_d,Int_bvnw_d,Int_bvbw_d,";
   os << "Int_bw_d,Int_combi_d,Int_nw_d,";
   os << "Int_tuss_d,Int_ww_d,";
 }
 
-void structStats::intensToCSV( ostream& os ) const {
+void structStats::intensToCSV( csvRow& os ) const {
   os << density( intensCnt, wordInclCnt ) << ","; // column: Int_d
   os << density( intensBvnwCnt, wordInclCnt ) << ","; /// column: Int_bvnw_d
   os << density( intensBvbwCnt, wordInclCnt ) << ","; // column: Int_bvbw_d
@@ -946,7 +935,7 @@ void structStats::intensToCSV( ostream& os ) const {
   os << density( intensWwCnt, wordInclCnt ) << ","; // column: Int_ww_d
 }
 
-void structStats::formalHeader( ostream& os ) const {
+void structStats::formalHeader( csvRow& os ) const {
   os << "Form_d,";
   os << "Form_d_z_vnw,";
   os << "Form_bvnw_d,";
@@ -959,7 +948,7 @@ void structStats::formalHeader( ostream& os ) const {
   os << "Form_znw_d,";
 }
 
-void structStats::formalToCSV( ostream& os ) const {
+void structStats::formalToCSV( csvRow& os ) const {
   os << density( formalCnt, wordInclCnt ) << ","; // column: Form_d
   os << density( formalCnt-formalVnwCnt, wordInclCnt ) << ","; // column: Form_d_z_vnw
   os << density( formalBvnwCnt, wordInclCnt ) << ","; // column: Form_bvnw_d
@@ -972,7 +961,7 @@ void structStats::formalToCSV( ostream& os ) const {
   os << density( formalZnwCnt, wordInclCnt ) << ","; // column: Form_znw_d
 }
 
-void structStats::miscHeader( ostream& os ) const {
+void structStats::miscHeader( csvRow& os ) const {
   os << "Log_prob_fwd,Log_prob_fwd_inhwrd,Log_prob_fwd_zn,Log_prob_fwd_inhwrd_zn,";
   os << "Entropie_fwd,Entropie_fwd_norm,Perplexiteit_fwd,Perplexiteit_fwd_norm,";
   os << "Log_prob_bwd,Log_prob_bwd_inhwrd,Log_prob_bwd_zn,Log_prob_bwd_inhwrd_zn,";
@@ -981,7 +970,7 @@ void structStats::miscHeader( ostream& os ) const {
   os << "LiNT_score1,LiNT_niveau1,LiNT_score2,LiNT_niveau2";
 }
 
-void structStats::miscToCSV( ostream& os ) const {
+void structStats::miscToCSV( csvRow& os ) const {
   os << proportion( avg_prob10_fwd, sentCnt ) << ",";
   os << proportion( avg_prob10_fwd_content, sentCnt ) << ",";
   os << proportion( avg_prob10_fwd_ex_names, sentCnt ) << ",";
@@ -999,7 +988,7 @@ void structStats::miscToCSV( ostream& os ) const {
   os << proportion( perplexity_bwd, sentCnt ) << ",";
   os << proportion( perplexity_bwd_norm, sentCnt ) << ",";
 
-  os << "\"" << escape_quotes(toStringCounter(my_classification)) << "\",";
+  os << csvQuoted( toStringCounter(my_classification) ) << ",";
 
   /* LINT scores */
   double wrd_freq_log_zn_corr = proportion(word_freq_log_n_corr, contentCnt-nameCnt).p;
@@ -1051,311 +1040,311 @@ void structStats::miscToCSV( ostream& os ) const {
 void structStats::addMetrics( ) const {
   folia::FoliaElement *el = folia_node;
   folia::Document *doc = el->doc();
-  addOneMetric( doc, el, "word_count", TiCC::toString(wordCnt) );
-  addOneMetric( doc, el, "word_count_incl_stopwords", TiCC::toString(wordInclCnt) );
-  addOneMetric( doc, el, "bv_vd_count", TiCC::toString(vdBvCnt) );
-  addOneMetric( doc, el, "nw_vd_count", TiCC::toString(vdNwCnt) );
-  addOneMetric( doc, el, "vrij_vd_count", TiCC::toString(vdVrijCnt) );
-  addOneMetric( doc, el, "bv_od_count", TiCC::toString(odBvCnt) );
-  addOneMetric( doc, el, "nw_od_count", TiCC::toString(odNwCnt) );
-  addOneMetric( doc, el, "vrij_od_count", TiCC::toString(odVrijCnt) );
-  addOneMetric( doc, el, "bv_inf_count", TiCC::toString(infBvCnt) );
-  addOneMetric( doc, el, "nw_inf_count", TiCC::toString(infNwCnt) );
-  addOneMetric( doc, el, "vrij_inf_count", TiCC::toString(infVrijCnt) );
-  addOneMetric( doc, el, "smain_count", TiCC::toString(smainCnt) );
-  addOneMetric( doc, el, "ssub_count", TiCC::toString(ssubCnt) );
-  addOneMetric( doc, el, "sv1_count", TiCC::toString(sv1Cnt) );
-  addOneMetric( doc, el, "smain_cnj_count", TiCC::toString(smainCnjCnt) );
-  addOneMetric( doc, el, "ssub_cnj_count", TiCC::toString(ssubCnjCnt) );
-  addOneMetric( doc, el, "sv1_cnj_count", TiCC::toString(sv1CnjCnt) );
-  addOneMetric( doc, el, "present_verb_count", TiCC::toString(presentCnt) );
-  addOneMetric( doc, el, "past_verb_count", TiCC::toString(pastCnt) );
-  addOneMetric( doc, el, "subjonct_count", TiCC::toString(subjonctCnt) );
-  addOneMetric( doc, el, "name_count", TiCC::toString(nameCnt) );
+  addOneMetric( doc, el, "word_count", wordCnt );
+  addOneMetric( doc, el, "word_count_incl_stopwords", wordInclCnt );
+  addOneMetric( doc, el, "bv_vd_count", vdBvCnt );
+  addOneMetric( doc, el, "nw_vd_count", vdNwCnt );
+  addOneMetric( doc, el, "vrij_vd_count", vdVrijCnt );
+  addOneMetric( doc, el, "bv_od_count", odBvCnt );
+  addOneMetric( doc, el, "nw_od_count", odNwCnt );
+  addOneMetric( doc, el, "vrij_od_count", odVrijCnt );
+  addOneMetric( doc, el, "bv_inf_count", infBvCnt );
+  addOneMetric( doc, el, "nw_inf_count", infNwCnt );
+  addOneMetric( doc, el, "vrij_inf_count", infVrijCnt );
+  addOneMetric( doc, el, "smain_count", smainCnt );
+  addOneMetric( doc, el, "ssub_count", ssubCnt );
+  addOneMetric( doc, el, "sv1_count", sv1Cnt );
+  addOneMetric( doc, el, "smain_cnj_count", smainCnjCnt );
+  addOneMetric( doc, el, "ssub_cnj_count", ssubCnjCnt );
+  addOneMetric( doc, el, "sv1_cnj_count", sv1CnjCnt );
+  addOneMetric( doc, el, "present_verb_count", presentCnt );
+  addOneMetric( doc, el, "past_verb_count", pastCnt );
+  addOneMetric( doc, el, "subjonct_count", subjonctCnt );
+  addOneMetric( doc, el, "name_count", nameCnt );
   int val = at( ners, NER::PER_B );
-  addOneMetric( doc, el, "personal_name_count", TiCC::toString(val) );
+  addOneMetric( doc, el, "personal_name_count", val );
   val = at( ners, NER::LOC_B );
-  addOneMetric( doc, el, "location_name_count", TiCC::toString(val) );
+  addOneMetric( doc, el, "location_name_count", val );
   val = at( ners, NER::ORG_B );
-  addOneMetric( doc, el, "organization_name_count", TiCC::toString(val) );
+  addOneMetric( doc, el, "organization_name_count", val );
   val = at( ners, NER::PRO_B );
-  addOneMetric( doc, el, "product_name_count", TiCC::toString(val) );
+  addOneMetric( doc, el, "product_name_count", val );
   val = at( ners, NER::EVE_B );
-  addOneMetric( doc, el, "event_name_count", TiCC::toString(val) );
+  addOneMetric( doc, el, "event_name_count", val );
   val = at( afks, Afk::OVERHEID_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "overheid_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "overheid_afk_count", val );
   }
   val = at( afks, Afk::JURIDISCH_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "juridisch_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "juridisch_afk_count", val );
   }
   val = at( afks, Afk::ONDERWIJS_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "onderwijs_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "onderwijs_afk_count", val );
   }
   val = at( afks, Afk::MEDIA_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "media_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "media_afk_count", val );
   }
   val = at( afks, Afk::GENERIEK_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "generiek_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "generiek_afk_count", val );
   }
   val = at( afks, Afk::OVERIGE_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "overige_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "overige_afk_count", val );
   }
   val = at( afks, Afk::INTERNATIONAAL_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "internationaal_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "internationaal_afk_count", val );
   }
   val = at( afks, Afk::ZORG_A );
   if ( val > 0 ){
-    addOneMetric( doc, el, "zorg_afk_count", TiCC::toString(val) );
+    addOneMetric( doc, el, "zorg_afk_count", val );
   }
 
-  addOneMetric( doc, el, "pers_pron_1_count", TiCC::toString(pron1Cnt) );
-  addOneMetric( doc, el, "pers_pron_2_count", TiCC::toString(pron2Cnt) );
-  addOneMetric( doc, el, "pers_pron_3_count", TiCC::toString(pron3Cnt) );
-  addOneMetric( doc, el, "passive_count", TiCC::toString(passiveCnt) );
-  addOneMetric( doc, el, "modal_count", TiCC::toString(modalCnt) );
-  addOneMetric( doc, el, "time_count", TiCC::toString(timeVCnt) );
-  addOneMetric( doc, el, "koppel_count", TiCC::toString(koppelCnt) );
-  addOneMetric( doc, el, "pers_ref_count", TiCC::toString(persRefCnt) );
-  addOneMetric( doc, el, "pron_ref_count", TiCC::toString(pronRefCnt) );
-  addOneMetric( doc, el, "archaic_count", TiCC::toString(archaicsCnt) );
-  addOneMetric( doc, el, "content_count", TiCC::toString(contentCnt) );
-  addOneMetric( doc, el, "content_strict_count", TiCC::toString(contentStrictCnt) );
-  addOneMetric( doc, el, "nominal_count", TiCC::toString(nominalCnt) );
-  addOneMetric( doc, el, "adj_count", TiCC::toString(adjCnt) );
-  addOneMetric( doc, el, "vg_count", TiCC::toString(vgCnt) );
-  addOneMetric( doc, el, "vnw_count", TiCC::toString(vnwCnt) );
-  addOneMetric( doc, el, "lid_count", TiCC::toString(lidCnt) );
-  addOneMetric( doc, el, "vz_count", TiCC::toString(vzCnt) );
-  addOneMetric( doc, el, "bw_count", TiCC::toString(bwCnt) );
-  addOneMetric( doc, el, "tw_count", TiCC::toString(twCnt) );
-  addOneMetric( doc, el, "noun_count", TiCC::toString(nounCnt) );
-  addOneMetric( doc, el, "verb_count", TiCC::toString(verbCnt) );
-  addOneMetric( doc, el, "tsw_count", TiCC::toString(tswCnt) );
-  addOneMetric( doc, el, "spec_count", TiCC::toString(specCnt) );
-  addOneMetric( doc, el, "let_count", TiCC::toString(letCnt) );
-  addOneMetric( doc, el, "rel_count", TiCC::toString(betrCnt) );
-  addOneMetric( doc, el, "all_connector_count", TiCC::toString(allConnCnt) );
-  addOneMetric( doc, el, "temporal_connector_count", TiCC::toString(tempConnCnt) );
-  addOneMetric( doc, el, "reeks_wg_connector_count", TiCC::toString(opsomWgConnCnt) );
-  addOneMetric( doc, el, "reeks_zin_connector_count", TiCC::toString(opsomZinConnCnt) );
-  addOneMetric( doc, el, "contrast_connector_count", TiCC::toString(contrastConnCnt) );
-  addOneMetric( doc, el, "comparatief_connector_count", TiCC::toString(compConnCnt) );
-  addOneMetric( doc, el, "causaal_connector_count", TiCC::toString(causeConnCnt) );
-  addOneMetric( doc, el, "time_situation_count", TiCC::toString(timeSitCnt) );
-  addOneMetric( doc, el, "space_situation_count", TiCC::toString(spaceSitCnt) );
-  addOneMetric( doc, el, "cause_situation_count", TiCC::toString(causeSitCnt) );
-  addOneMetric( doc, el, "emotion_situation_count", TiCC::toString(emoSitCnt) );
-  addOneMetric( doc, el, "prop_neg_count", TiCC::toString(propNegCnt) );
-  addOneMetric( doc, el, "morph_neg_count", TiCC::toString(morphNegCnt) );
-  addOneMetric( doc, el, "multiple_neg_count", TiCC::toString(multiNegCnt) );
-  addOneMetric( doc, el, "voorzetsel_expression_count", TiCC::toString(prepExprCnt) );
+  addOneMetric( doc, el, "pers_pron_1_count", pron1Cnt );
+  addOneMetric( doc, el, "pers_pron_2_count", pron2Cnt );
+  addOneMetric( doc, el, "pers_pron_3_count", pron3Cnt );
+  addOneMetric( doc, el, "passive_count", passiveCnt );
+  addOneMetric( doc, el, "modal_count", modalCnt );
+  addOneMetric( doc, el, "time_count", timeVCnt );
+  addOneMetric( doc, el, "koppel_count", koppelCnt );
+  addOneMetric( doc, el, "pers_ref_count", persRefCnt );
+  addOneMetric( doc, el, "pron_ref_count", pronRefCnt );
+  addOneMetric( doc, el, "archaic_count", archaicsCnt );
+  addOneMetric( doc, el, "content_count", contentCnt );
+  addOneMetric( doc, el, "content_strict_count", contentStrictCnt );
+  addOneMetric( doc, el, "nominal_count", nominalCnt );
+  addOneMetric( doc, el, "adj_count", adjCnt );
+  addOneMetric( doc, el, "vg_count", vgCnt );
+  addOneMetric( doc, el, "vnw_count", vnwCnt );
+  addOneMetric( doc, el, "lid_count", lidCnt );
+  addOneMetric( doc, el, "vz_count", vzCnt );
+  addOneMetric( doc, el, "bw_count", bwCnt );
+  addOneMetric( doc, el, "tw_count", twCnt );
+  addOneMetric( doc, el, "noun_count", nounCnt );
+  addOneMetric( doc, el, "verb_count", verbCnt );
+  addOneMetric( doc, el, "tsw_count", tswCnt );
+  addOneMetric( doc, el, "spec_count", specCnt );
+  addOneMetric( doc, el, "let_count", letCnt );
+  addOneMetric( doc, el, "rel_count", betrCnt );
+  addOneMetric( doc, el, "all_connector_count", allConnCnt );
+  addOneMetric( doc, el, "temporal_connector_count", tempConnCnt );
+  addOneMetric( doc, el, "reeks_wg_connector_count", opsomWgConnCnt );
+  addOneMetric( doc, el, "reeks_zin_connector_count", opsomZinConnCnt );
+  addOneMetric( doc, el, "contrast_connector_count", contrastConnCnt );
+  addOneMetric( doc, el, "comparatief_connector_count", compConnCnt );
+  addOneMetric( doc, el, "causaal_connector_count", causeConnCnt );
+  addOneMetric( doc, el, "time_situation_count", timeSitCnt );
+  addOneMetric( doc, el, "space_situation_count", spaceSitCnt );
+  addOneMetric( doc, el, "cause_situation_count", causeSitCnt );
+  addOneMetric( doc, el, "emotion_situation_count", emoSitCnt );
+  addOneMetric( doc, el, "prop_neg_count", propNegCnt );
+  addOneMetric( doc, el, "morph_neg_count", morphNegCnt );
+  addOneMetric( doc, el, "multiple_neg_count", multiNegCnt );
+  addOneMetric( doc, el, "voorzetsel_expression_count", prepExprCnt );
   addOneMetric( doc, el,
-    "word_overlap_count", TiCC::toString( wordOverlapCnt ) );
+    "word_overlap_count", wordOverlapCnt );
   addOneMetric( doc, el,
-    "lemma_overlap_count", TiCC::toString( lemmaOverlapCnt ) );
-  addOneMetric( doc, el, "prevalenceP", TiCC::toString(prevalenceP) );
-  addOneMetric( doc, el, "prevalenceZ", TiCC::toString(prevalenceZ) );
-  addOneMetric( doc, el, "prevalenceContentP", TiCC::toString(prevalenceContentP) );
-  addOneMetric( doc, el, "prevalenceContentZ", TiCC::toString(prevalenceContentZ) );
-  addOneMetric( doc, el, "prevalenceCovered", TiCC::toString(prevalenceCovered) );
-  addOneMetric( doc, el, "prevalenceContentCovered", TiCC::toString(prevalenceContentCovered) );
-  addOneMetric( doc, el, "freq50", TiCC::toString(f50Cnt) );
-  addOneMetric( doc, el, "freq65", TiCC::toString(f65Cnt) );
-  addOneMetric( doc, el, "freq77", TiCC::toString(f77Cnt) );
-  addOneMetric( doc, el, "freq80", TiCC::toString(f80Cnt) );
-
-  addOneMetric( doc, el, "top1000", TiCC::toString(top1000Cnt) );
-  addOneMetric( doc, el, "top2000", TiCC::toString(top2000Cnt) );
-  addOneMetric( doc, el, "top3000", TiCC::toString(top3000Cnt) );
-  addOneMetric( doc, el, "top5000", TiCC::toString(top5000Cnt) );
-  addOneMetric( doc, el, "top10000", TiCC::toString(top10000Cnt) );
-  addOneMetric( doc, el, "top20000", TiCC::toString(top20000Cnt) );
-  addOneMetric( doc, el, "top1000Content", TiCC::toString(top1000ContentCnt) );
-  addOneMetric( doc, el, "top2000Content", TiCC::toString(top2000ContentCnt) );
-  addOneMetric( doc, el, "top3000Content", TiCC::toString(top3000ContentCnt) );
-  addOneMetric( doc, el, "top5000Content", TiCC::toString(top5000ContentCnt) );
-  addOneMetric( doc, el, "top10000Content", TiCC::toString(top10000ContentCnt) );
-  addOneMetric( doc, el, "top20000Content", TiCC::toString(top20000ContentCnt) );
-  addOneMetric( doc, el, "top1000StrictContent", TiCC::toString(top1000ContentStrictCnt) );
-  addOneMetric( doc, el, "top2000StrictContent", TiCC::toString(top2000ContentStrictCnt) );
-  addOneMetric( doc, el, "top3000StrictContent", TiCC::toString(top3000ContentStrictCnt) );
-  addOneMetric( doc, el, "top5000StrictContent", TiCC::toString(top5000ContentStrictCnt) );
-  addOneMetric( doc, el, "top10000StrictContent", TiCC::toString(top10000ContentStrictCnt) );
-  addOneMetric( doc, el, "top20000StrictContent", TiCC::toString(top20000ContentStrictCnt) );
-
-  addOneMetric( doc, el, "word_freq", TiCC::toString(word_freq) );
-  addOneMetric( doc, el, "word_freq_no_names", TiCC::toString(word_freq_n) );
+    "lemma_overlap_count", lemmaOverlapCnt );
+  addOneMetric( doc, el, "prevalenceP", prevalenceP );
+  addOneMetric( doc, el, "prevalenceZ", prevalenceZ );
+  addOneMetric( doc, el, "prevalenceContentP", prevalenceContentP );
+  addOneMetric( doc, el, "prevalenceContentZ", prevalenceContentZ );
+  addOneMetric( doc, el, "prevalenceCovered", prevalenceCovered );
+  addOneMetric( doc, el, "prevalenceContentCovered", prevalenceContentCovered );
+  addOneMetric( doc, el, "freq50", f50Cnt );
+  addOneMetric( doc, el, "freq65", f65Cnt );
+  addOneMetric( doc, el, "freq77", f77Cnt );
+  addOneMetric( doc, el, "freq80", f80Cnt );
+
+  addOneMetric( doc, el, "top1000", top1000Cnt );
+  addOneMetric( doc, el, "top2000", top2000Cnt );
+  addOneMetric( doc, el, "top3000", top3000Cnt );
+  addOneMetric( doc, el, "top5000", top5000Cnt );
+  addOneMetric( doc, el, "top10000", top10000Cnt );
+  addOneMetric( doc, el, "top20000", top20000Cnt );
+  addOneMetric( doc, el, "top1000Content", top1000ContentCnt );
+  addOneMetric( doc, el, "top2000Content", top2000ContentCnt );
+  addOneMetric( doc, el, "top3000Content", top3000ContentCnt );
+  addOneMetric( doc, el, "top5000Content", top5000ContentCnt );
+  addOneMetric( doc, el, "top10000Content", top10000ContentCnt );
+  addOneMetric( doc, el, "top20000Content", top20000ContentCnt );
+  addOneMetric( doc, el, "top1000StrictContent", top1000ContentStrictCnt );
+  addOneMetric( doc, el, "top2000StrictContent", top2000ContentStrictCnt );
+  addOneMetric( doc, el, "top3000StrictContent", top3000ContentStrictCnt );
+  addOneMetric( doc, el, "top5000StrictContent", top5000ContentStrictCnt );
+  addOneMetric( doc, el, "top10000StrictContent", top10000ContentStrictCnt );
+  addOneMetric( doc, el, "top20000StrictContent", top20000ContentStrictCnt );
+
+  addOneMetric( doc, el, "word_freq", word_freq );
+  addOneMetric( doc, el, "word_freq_no_names", word_freq_n );
   if ( !std::isnan(word_freq_log)  )
-    addOneMetric( doc, el, "log_word_freq", TiCC::toString(word_freq_log) );
+    addOneMetric( doc, el, "log_word_freq", word_freq_log );
   if ( !std::isnan(word_freq_log_n)  )
-    addOneMetric( doc, el, "log_word_freq_no_names", TiCC::toString(word_freq_log_n) );
-  addOneMetric( doc, el, "lemma_freq", TiCC::toString(lemma_freq) );
-  addOneMetric( doc, el, "lemma_freq_no_names", TiCC::toString(lemma_freq_n) );
+    addOneMetric( doc, el, "log_word_freq_no_names", word_freq_log_n );
+  addOneMetric( doc, el, "lemma_freq", lemma_freq );
+  addOneMetric( doc, el, "lemma_freq_no_names", lemma_freq_n );
   if ( !std::isnan(lemma_freq_log)  )
-    addOneMetric( doc, el, "log_lemma_freq", TiCC::toString(lemma_freq_log) );
+    addOneMetric( doc, el, "log_lemma_freq", lemma_freq_log );
   if ( !std::isnan(lemma_freq_log_n)  )
-    addOneMetric( doc, el, "log_lemma_freq_no_names", TiCC::toString(lemma_freq_log_n) );
+    addOneMetric( doc, el, "log_lemma_freq_no_names", lemma_freq_log_n );
 
   if ( !std::isnan(word_freq_log_strict)  )
-    addOneMetric( doc, el, "log_word_freq_strict", TiCC::toString(word_freq_log_strict) );
+    addOneMetric( doc, el, "log_word_freq_strict", word_freq_log_strict );
   if ( !std::isnan(word_freq_log_n_strict)  )
-    addOneMetric( doc, el, "log_word_freq_no_names_strict", TiCC::toString(word_freq_log_n_strict) );
+    addOneMetric( doc, el, "log_word_freq_no_names_strict", word_freq_log_n_strict );
   if ( !std::isnan(lemma_freq_log_strict)  )
-    addOneMetric( doc, el, "log_lemma_freq_strict", TiCC::toString(lemma_freq_log_strict) );
+    addOneMetric( doc, el, "log_lemma_freq_strict", lemma_freq_log_strict );
   if ( !std::isnan(lemma_freq_log_n_strict)  )
-    addOneMetric( doc, el, "log_lemma_freq_no_names_strict", TiCC::toString(lemma_freq_log_n_strict) );
+    addOneMetric( doc, el, "log_lemma_freq_no_names_strict", lemma_freq_log_n_strict );
 
   if ( !std::isnan(avg_prob10_fwd) )
-    addOneMetric( doc, el, "wopr_logprob_fwd", TiCC::toString(avg_prob10_fwd) );
+    addOneMetric( doc, el, "wopr_logprob_fwd", avg_prob10_fwd );
   if ( !std::isnan(entropy_fwd) )
-    addOneMetric( doc, el, "wopr_entropy_fwd", TiCC::toString(entropy_fwd) );
+    addOneMetric( doc, el, "wopr_entropy_fwd", entropy_fwd );
   if ( !std::isnan(perplexity_fwd) )
-    addOneMetric( doc, el, "wopr_perplexity_fwd", TiCC::toString(perplexity_fwd) );
+    addOneMetric( doc, el, "wopr_perplexity_fwd", perplexity_fwd );
   if ( !std::isnan(avg_prob10_bwd) )
-    addOneMetric( doc, el, "wopr_logprob_bwd", TiCC::toString(avg_prob10_bwd) );
+    addOneMetric( doc, el, "wopr_logprob_bwd", avg_prob10_bwd );
   if ( !std::isnan(entropy_bwd) )
-    addOneMetric( doc, el, "wopr_entropy_bwd", TiCC::toString(entropy_bwd) );
+    addOneMetric( doc, el, "wopr_entropy_bwd", entropy_bwd );
   if ( !std::isnan(perplexity_bwd) )
-    addOneMetric( doc, el, "wopr_perplexity_bwd", TiCC::toString(perplexity_bwd) );
-
-  addOneMetric( doc, el, "broad_adj", TiCC::toString(broadAdjCnt) );
-  addOneMetric( doc, el, "strict_adj", TiCC::toString(strictAdjCnt) );
-  addOneMetric( doc, el, "human_adj_count", TiCC::toString(humanAdjCnt) );
-  addOneMetric( doc, el, "emo_adj_count", TiCC::toString(emoAdjCnt) );
-  addOneMetric( doc, el, "nonhuman_adj_count", TiCC::toString(nonhumanAdjCnt) );
-  addOneMetric( doc, el, "shape_adj_count", TiCC::toString(shapeAdjCnt) );
-  addOneMetric( doc, el, "color_adj_count", TiCC::toString(colorAdjCnt) );
-  addOneMetric( doc, el, "matter_adj_count", TiCC::toString(matterAdjCnt) );
-  addOneMetric( doc, el, "sound_adj_count", TiCC::toString(soundAdjCnt) );
-  addOneMetric( doc, el, "other_nonhuman_adj_count", TiCC::toString(nonhumanOtherAdjCnt) );
-  addOneMetric( doc, el, "techn_adj_count", TiCC::toString(techAdjCnt) );
-  addOneMetric( doc, el, "time_adj_count", TiCC::toString(timeAdjCnt) );
-  addOneMetric( doc, el, "place_adj_count", TiCC::toString(placeAdjCnt) );
-  addOneMetric( doc, el, "pos_spec_adj_count", TiCC::toString(specPosAdjCnt) );
-  addOneMetric( doc, el, "neg_spec_adj_count", TiCC::toString(specNegAdjCnt) );
-  addOneMetric( doc, el, "pos_adj_count", TiCC::toString(posAdjCnt) );
-  addOneMetric( doc, el, "neg_adj_count", TiCC::toString(negAdjCnt) );
-  addOneMetric( doc, el, "evaluative_adj_count", TiCC::toString(evaluativeAdjCnt) );
-  addOneMetric( doc, el, "pos_epi_adj_count", TiCC::toString(epiPosAdjCnt) );
-  addOneMetric( doc, el, "neg_epi_adj_count", TiCC::toString(epiNegAdjCnt) );
-  addOneMetric( doc, el, "abstract_adj", TiCC::toString(abstractAdjCnt) );
-  addOneMetric( doc, el, "undefined_adj_count", TiCC::toString(undefinedAdjCnt) );
-  addOneMetric( doc, el, "covered_adj_count", TiCC::toString(adjCnt-uncoveredAdjCnt) );
-  addOneMetric( doc, el, "uncovered_adj_count", TiCC::toString(uncoveredAdjCnt) );
-
-  addOneMetric( doc, el, "intens_count", TiCC::toString(intensCnt) );
-  addOneMetric( doc, el, "intens_bvnw_count", TiCC::toString(intensBvnwCnt) );
-  addOneMetric( doc, el, "intens_bvbw_count", TiCC::toString(intensBvbwCnt) );
-  addOneMetric( doc, el, "intens_bw_count", TiCC::toString(intensBwCnt) );
-  addOneMetric( doc, el, "intens_combi_count", TiCC::toString(intensCombiCnt) );
-  addOneMetric( doc, el, "intens_nw_count", TiCC::toString(intensNwCnt) );
-  addOneMetric( doc, el, "intens_tuss_count", TiCC::toString(intensTussCnt) );
-  addOneMetric( doc, el, "intens_ww_count", TiCC::toString(intensWwCnt) );
-
-  addOneMetric( doc, el, "formal_count", TiCC::toString(formalCnt) );
-  addOneMetric( doc, el, "formal_bvnw_count", TiCC::toString(formalBvnwCnt) );
-  addOneMetric( doc, el, "formal_bw_count", TiCC::toString(formalBwCnt) );
-  addOneMetric( doc, el, "formal_vgw_count", TiCC::toString(formalVgwCnt) );
-  addOneMetric( doc, el, "formal_vnw_count", TiCC::toString(formalVnwCnt) );
-  addOneMetric( doc, el, "formal_vz_count", TiCC::toString(formalVzCnt) );
-  addOneMetric( doc, el, "formal_vzg_count", TiCC::toString(formalVzgCnt) );
-  addOneMetric( doc, el, "formal_ww_count", TiCC::toString(formalWwCnt) );
-  addOneMetric( doc, el, "formal_znw_count", TiCC::toString(formalZnwCnt) );  
-
-  addOneMetric( doc, el, "general_noun_count", TiCC::toString(generalNounCnt) );
-  addOneMetric( doc, el, "general_noun_sep_count", TiCC::toString(generalNounSepCnt) );
-  addOneMetric( doc, el, "general_noun_rel_count", TiCC::toString(generalNounRelCnt) );
-  addOneMetric( doc, el, "general_noun_act_count", TiCC::toString(generalNounActCnt) );
-  addOneMetric( doc, el, "general_noun_know_count", TiCC::toString(generalNounKnowCnt) );
-  addOneMetric( doc, el, "general_noun_disc_count", TiCC::toString(generalNounDiscCnt) );
-  addOneMetric( doc, el, "general_noun_deve_count", TiCC::toString(generalNounDeveCnt) );
-
-  addOneMetric( doc, el, "general_verb_count", TiCC::toString(generalVerbCnt) );
-  addOneMetric( doc, el, "general_verb_sep_count", TiCC::toString(generalVerbSepCnt) );
-  addOneMetric( doc, el, "general_verb_rel_count", TiCC::toString(generalVerbRelCnt) );
-  addOneMetric( doc, el, "general_verb_act_count", TiCC::toString(generalVerbActCnt) );
-  addOneMetric( doc, el, "general_verb_know_count", TiCC::toString(generalVerbKnowCnt) );
-  addOneMetric( doc, el, "general_verb_disc_count", TiCC::toString(generalVerbDiscCnt) );
-  addOneMetric( doc, el, "general_verb_deve_count", TiCC::toString(generalVerbDeveCnt) );
-
-  addOneMetric( doc, el, "general_adverb_count", TiCC::toString(generalAdverbCnt) );
-  addOneMetric( doc, el, "specific_adverb_count", TiCC::toString(specificAdverbCnt) );
-
-  addOneMetric( doc, el, "broad_noun", TiCC::toString(broadNounCnt) );
-  addOneMetric( doc, el, "strict_noun", TiCC::toString(strictNounCnt) );
-  addOneMetric( doc, el, "human_nouns_count", TiCC::toString(humanCnt) );
-  addOneMetric( doc, el, "nonhuman_nouns_count", TiCC::toString(nonHumanCnt) );
-  addOneMetric( doc, el, "artefact_nouns_count", TiCC::toString(artefactCnt) );
-  addOneMetric( doc, el, "concrother_nouns_count", TiCC::toString(concrotherCnt) );
-  addOneMetric( doc, el, "substance_conc_nouns_count", TiCC::toString(substanceConcCnt) );
-  addOneMetric( doc, el, "foodcare_nouns_count", TiCC::toString(foodcareCnt) );
-  addOneMetric( doc, el, "time_nouns_count", TiCC::toString(timeCnt) );
-  addOneMetric( doc, el, "place_nouns_count", TiCC::toString(placeCnt) );
-  addOneMetric( doc, el, "measure_nouns_count", TiCC::toString(measureCnt) );
-  addOneMetric( doc, el, "dynamic_conc_nouns_count", TiCC::toString(dynamicConcCnt) );
-  addOneMetric( doc, el, "substance_abstr_nouns_count", TiCC::toString(substanceAbstrCnt) );
-  addOneMetric( doc, el, "dynamic_abstr_nouns_count", TiCC::toString(dynamicAbstrCnt) );
-  addOneMetric( doc, el, "nondynamic_nouns_count", TiCC::toString(nonDynamicCnt) );
-  addOneMetric( doc, el, "institut_nouns_count", TiCC::toString(institutCnt) );
-  addOneMetric( doc, el, "undefined_nouns_count", TiCC::toString(undefinedNounCnt) );
-  addOneMetric( doc, el, "covered_nouns_count", TiCC::toString(nounCnt+nameCnt-uncoveredNounCnt) );
-  addOneMetric( doc, el, "uncovered_nouns_count", TiCC::toString(uncoveredNounCnt) );
-
-  addOneMetric( doc, el, "abstract_ww", TiCC::toString(abstractWwCnt) );
-  addOneMetric( doc, el, "concrete_ww", TiCC::toString(concreteWwCnt) );
-  addOneMetric( doc, el, "undefined_ww", TiCC::toString(undefinedWwCnt) );
-  addOneMetric( doc, el, "undefined_ATP", TiCC::toString(undefinedATPCnt) );
-  addOneMetric( doc, el, "state_count", TiCC::toString(stateCnt) );
-  addOneMetric( doc, el, "action_count", TiCC::toString(actionCnt) );
-  addOneMetric( doc, el, "process_count", TiCC::toString(processCnt) );
-  addOneMetric( doc, el, "covered_verb_count", TiCC::toString(verbCnt-uncoveredVerbCnt) );
-  addOneMetric( doc, el, "uncovered_verb_count", TiCC::toString(uncoveredVerbCnt) );
-  addOneMetric( doc, el, "indef_np_count", TiCC::toString(indefNpCnt) );
-  addOneMetric( doc, el, "np_count", TiCC::toString(npCnt) );
-  addOneMetric( doc, el, "np_size", TiCC::toString(npSize) );
-  addOneMetric( doc, el, "vc_modifier_count", TiCC::toString(vcModCnt) );
-  addOneMetric( doc, el, "vc_modifier_single_count", TiCC::toString(vcModSingleCnt) );
-  addOneMetric( doc, el, "adj_np_modifier_count", TiCC::toString(adjNpModCnt) );
-  addOneMetric( doc, el, "np_modifier_count", TiCC::toString(npModCnt) );
-
-  addOneMetric( doc, el, "character_count", TiCC::toString(charCnt) );
-  addOneMetric( doc, el, "character_count_min_names", TiCC::toString(charCntExNames) );
-  addOneMetric( doc, el, "morpheme_count", TiCC::toString(morphCnt) );
-  addOneMetric( doc, el, "morpheme_count_min_names", TiCC::toString(morphCntExNames) );
+    addOneMetric( doc, el, "wopr_perplexity_bwd", perplexity_bwd );
+
+  addOneMetric( doc, el, "broad_adj", broadAdjCnt );
+  addOneMetric( doc, el, "strict_adj", strictAdjCnt );
+  addOneMetric( doc, el, "human_adj_count", humanAdjCnt );
+  addOneMetric( doc, el, "emo_adj_count", emoAdjCnt );
+  addOneMetric( doc, el, "nonhuman_adj_count", nonhumanAdjCnt );
+  addOneMetric( doc, el, "shape_adj_count", shapeAdjCnt );
+  addOneMetric( doc, el, "color_adj_count", colorAdjCnt );
+  addOneMetric( doc, el, "matter_adj_count", matterAdjCnt );
+  addOneMetric( doc, el, "sound_adj_count", soundAdjCnt );
+  addOneMetric( doc, el, "other_nonhuman_adj_count", nonhumanOtherAdjCnt );
+  addOneMetric( doc, el, "techn_adj_count", techAdjCnt );
+  addOneMetric( doc, el, "time_adj_count", timeAdjCnt );
+  addOneMetric( doc, el, "place_adj_count", placeAdjCnt );
+  addOneMetric( doc, el, "pos_spec_adj_count", specPosAdjCnt );
+  addOneMetric( doc, el, "neg_spec_adj_count", specNegAdjCnt );
+  addOneMetric( doc, el, "pos_adj_count", posAdjCnt );
+  addOneMetric( doc, el, "neg_adj_count", negAdjCnt );
+  addOneMetric( doc, el, "evaluative_adj_count", evaluativeAdjCnt );
+  addOneMetric( doc, el, "pos_epi_adj_count", epiPosAdjCnt );
+  addOneMetric( doc, el, "neg_epi_adj_count", epiNegAdjCnt );
+  addOneMetric( doc, el, "abstract_adj", abstractAdjCnt );
+  addOneMetric( doc, el, "undefined_adj_count", undefinedAdjCnt );
+  addOneMetric( doc, el, "covered_adj_count", adjCnt-uncoveredAdjCnt );
+  addOneMetric( doc, el, "uncovered_adj_count", uncoveredAdjCnt );
+
+  addOneMetric( doc, el, "intens_count", intensCnt );
+  addOneMetric( doc, el, "intens_bvnw_count", intensBvnwCnt );
+  addOneMetric( doc, el, "intens_bvbw_count", intensBvbwCnt );
+  addOneMetric( doc, el, "intens_bw_count", intensBwCnt );
+  addOneMetric( doc, el, "intens_combi_count", intensCombiCnt );
+  addOneMetric( doc, el, "intens_nw_count", intensNwCnt );
+  addOneMetric( doc, el, "intens_tuss_count", intensTussCnt );
+  addOneMetric( doc, el, "intens_ww_count", intensWwCnt );
+
+  addOneMetric( doc, el, "formal_count", formalCnt );
+  addOneMetric( doc, el, "formal_bvnw_count", formalBvnwCnt );
+  addOneMetric( doc, el, "formal_bw_count", formalBwCnt );
+  addOneMetric( doc, el, "formal_vgw_count", formalVgwCnt );
+  addOneMetric( doc, el, "formal_vnw_count", formalVnwCnt );
+  addOneMetric( doc, el, "formal_vz_count", formalVzCnt );
+  addOneMetric( doc, el, "formal_vzg_count", formalVzgCnt );
+  addOneMetric( doc, el, "formal_ww_count", formalWwCnt );
+  addOneMetric( doc, el, "formal_znw_count", formalZnwCnt );  
+
+  addOneMetric( doc, el, "general_noun_count", generalNounCnt );
+  addOneMetric( doc, el, "general_noun_sep_count", generalNounSepCnt );
+  addOneMetric( doc, el, "general_noun_rel_count", generalNounRelCnt );
+  addOneMetric( doc, el, "general_noun_act_count", generalNounActCnt );
+  addOneMetric( doc, el, "general_noun_know_count", generalNounKnowCnt );
+  addOneMetric( doc, el, "general_noun_disc_count", generalNounDiscCnt );
+  addOneMetric( doc, el, "general_noun_deve_count", generalNounDeveCnt );
+
+  addOneMetric( doc, el, "general_verb_count", generalVerbCnt );
+  addOneMetric( doc, el, "general_verb_sep_count", generalVerbSepCnt );
+  addOneMetric( doc, el, "general_verb_rel_count", generalVerbRelCnt );
+  addOneMetric( doc, el, "general_verb_act_count", generalVerbActCnt );
+  addOneMetric( doc, el, "general_verb_know_count", generalVerbKnowCnt );
+  addOneMetric( doc, el, "general_verb_disc_count", generalVerbDiscCnt );
+  addOneMetric( doc, el, "general_verb_deve_count", generalVerbDeveCnt );
+
+  addOneMetric( doc, el, "general_adverb_count", generalAdverbCnt );
+  addOneMetric( doc, el, "specific_adverb_count", specificAdverbCnt );
+
+  addOneMetric( doc, el, "broad_noun", broadNounCnt );
+  addOneMetric( doc, el, "strict_noun", strictNounCnt );
+  addOneMetric( doc, el, "human_nouns_count", humanCnt );
+  addOneMetric( doc, el, "nonhuman_nouns_count", nonHumanCnt );
+  addOneMetric( doc, el, "artefact_nouns_count", artefactCnt );
+  addOneMetric( doc, el, "concrother_nouns_count", concrotherCnt );
+  addOneMetric( doc, el, "substance_conc_nouns_count", substanceConcCnt );
+  addOneMetric( doc, el, "foodcare_nouns_count", foodcareCnt );
+  addOneMetric( doc, el, "time_nouns_count", timeCnt );
+  addOneMetric( doc, el, "place_nouns_count", placeCnt );
+  addOneMetric( doc, el, "measure_nouns_count", measureCnt );
+  addOneMetric( doc, el, "dynamic_conc_nouns_count", dynamicConcCnt );
+  addOneMetric( doc, el, "substance_abstr_nouns_count", substanceAbstrCnt );
+  addOneMetric( doc, el, "dynamic_abstr_nouns_count", dynamicAbstrCnt );
+  addOneMetric( doc, el, "nondynamic_nouns_count", nonDynamicCnt );
+  addOneMetric( doc, el, "institut_nouns_count", institutCnt );
+  addOneMetric( doc, el, "undefined_nouns_count", undefinedNounCnt );
+  addOneMetric( doc, el, "covered_nouns_count", nounCnt+nameCnt-uncoveredNounCnt );
+  addOneMetric( doc, el, "uncovered_nouns_count", uncoveredNounCnt );
+
+  addOneMetric( doc, el, "abstract_ww", abstractWwCnt );
+  addOneMetric( doc, el, "concrete_ww", concreteWwCnt );
+  addOneMetric( doc, el, "undefined_ww", undefinedWwCnt );
+  addOneMetric( doc, el, "undefined_ATP", undefinedATPCnt );
+  addOneMetric( doc, el, "state_count", stateCnt );
+  addOneMetric( doc, el, "action_count", actionCnt );
+  addOneMetric( doc, el, "process_count", processCnt );
+  addOneMetric( doc, el, "covered_verb_count", verbCnt-uncoveredVerbCnt );
+  addOneMetric( doc, el, "uncovered_verb_count", uncoveredVerbCnt );
+  addOneMetric( doc, el, "indef_np_count", indefNpCnt );
+  addOneMetric( doc, el, "np_count", npCnt );
+  addOneMetric( doc, el, "np_size", npSize );
+  addOneMetric( doc, el, "vc_modifier_count", vcModCnt );
+  addOneMetric( doc, el, "vc_modifier_single_count", vcModSingleCnt );
+  addOneMetric( doc, el, "adj_np_modifier_count", adjNpModCnt );
+  addOneMetric( doc, el, "np_modifier_count", npModCnt );
+
+  addOneMetric( doc, el, "character_count", charCnt );
+  addOneMetric( doc, el, "character_count_min_names", charCntExNames );
+  addOneMetric( doc, el, "morpheme_count", morphCnt );
+  addOneMetric( doc, el, "morpheme_count_min_names", morphCntExNames );
   if ( dLevel >= 0 )
-    addOneMetric( doc, el, "d_level", TiCC::toString(dLevel) );
+    addOneMetric( doc, el, "d_level", dLevel );
   else
     addOneMetric( doc, el, "d_level", "missing" );
   if ( dLevel_gt4 != 0 )
-    addOneMetric( doc, el, "d_level_gt4", TiCC::toString(dLevel_gt4) );
+    addOneMetric( doc, el, "d_level_gt4", dLevel_gt4 );
   if ( questCnt > 0 )
-    addOneMetric( doc, el, "question_count", TiCC::toString(questCnt) );
+    addOneMetric( doc, el, "question_count", questCnt );
   if ( impCnt > 0 )
-    addOneMetric( doc, el, "imperative_count", TiCC::toString(impCnt) );
-  addOneMetric( doc, el, "sub_verb_dist", MMtoString( distances, SUB_VERB ) );
-  addOneMetric( doc, el, "obj_verb_dist", MMtoString( distances, OBJ1_VERB ) );
-  addOneMetric( doc, el, "lijdend_verb_dist", MMtoString( distances, OBJ2_VERB ) );
-  addOneMetric( doc, el, "verb_pp_dist", MMtoString( distances, VERB_PP ) );
-  addOneMetric( doc, el, "noun_det_dist", MMtoString( distances, NOUN_DET ) );
-  addOneMetric( doc, el, "prep_obj_dist", MMtoString( distances, PREP_OBJ1 ) );
-  addOneMetric( doc, el, "verb_vc_dist", MMtoString( distances, VERB_VC ) );
-  addOneMetric( doc, el, "comp_body_dist", MMtoString( distances, COMP_BODY ) );
-  addOneMetric( doc, el, "crd_cnj_dist", MMtoString( distances, CRD_CNJ ) );
-  addOneMetric( doc, el, "verb_comp_dist", MMtoString( distances, VERB_COMP ) );
-  addOneMetric( doc, el, "noun_vc_dist", MMtoString( distances, NOUN_VC ) );
-  addOneMetric( doc, el, "verb_svp_dist", MMtoString( distances, VERB_SVP ) );
-  addOneMetric( doc, el, "verb_cop_dist", MMtoString( distances, VERB_PREDC_N ) );
-  addOneMetric( doc, el, "verb_adj_dist", MMtoString( distances, VERB_PREDC_A ) );
-  addOneMetric( doc, el, "verb_bw_mod_dist", MMtoString( distances, VERB_MOD_BW ) );
-  addOneMetric( doc, el, "verb_adv_mod_dist", MMtoString( distances, VERB_MOD_A ) );
-  addOneMetric( doc, el, "verb_noun_dist", MMtoString( distances, VERB_NOUN ) );
+    addOneMetric( doc, el, "imperative_count", impCnt );
+  addOneMetric( doc, el, "sub_verb_dist", distances.mean( SUB_VERB ) );
+  addOneMetric( doc, el, "obj_verb_dist", distances.mean( OBJ1_VERB ) );
+  addOneMetric( doc, el, "lijdend_verb_dist", distances.mean( OBJ2_VERB ) );
+  addOneMetric( doc, el, "verb_pp_dist", distances.mean( VERB_PP ) );
+  addOneMetric( doc, el, "noun_det_dist", distances.mean( NOUN_DET ) );
+  addOneMetric( doc, el, "prep_obj_dist", distances.mean( PREP_OBJ1 ) );
+  addOneMetric( doc, el, "verb_vc_dist", distances.mean( VERB_VC ) );
+  addOneMetric( doc, el, "comp_body_dist", distances.mean( COMP_BODY ) );
+  addOneMetric( doc, el, "crd_cnj_dist", distances.mean( CRD_CNJ ) );
+  addOneMetric( doc, el, "verb_comp_dist", distances.mean( VERB_COMP ) );
+  addOneMetric( doc, el, "noun_vc_dist", distances.mean( NOUN_VC ) );
+  addOneMetric( doc, el, "verb_svp_dist", distances.mean( VERB_SVP ) );
+  addOneMetric( doc, el, "verb_cop_dist", distances.mean( VERB_PREDC_N ) );
+  addOneMetric( doc, el, "verb_adj_dist", distances.mean( VERB_PREDC_A ) );
+  addOneMetric( doc, el, "verb_bw_mod_dist", distances.mean( VERB_MOD_BW ) );
+  addOneMetric( doc, el, "verb_adv_mod_dist", distances.mean( VERB_MOD_A ) );
+  addOneMetric( doc, el, "verb_noun_dist", distances.mean( VERB_NOUN ) );
 
   if ( !my_classification.empty() )
     addOneMetric( doc, el, "my_classification", toStringCounter(my_classification) );
@@ -1372,324 +1361,55 @@ void structStats::addMetrics( ) const {
  *******/
 
 void structStats::merge( structStats *ss ){
+#define MERGE_SUM( name ) name += ss->name;
+  STRUCT_INT_SUMS( MERGE_SUM )
+  STRUCT_DOUBLE_SUMS( MERGE_SUM )
+#undef MERGE_SUM
   if ( ss->parseFailCnt == -1 ) // not parsed
     parseFailCnt = -1;
   else
     parseFailCnt += ss->parseFailCnt;
-  wordCnt += ss->wordCnt;
-  wordInclCnt += ss->wordInclCnt;
   if ( ss->wordCnt != 0 ) // don't count sentences without words
     sentCnt += ss->sentCnt;
   charCnt += ss->charCnt;
   charCntExNames += ss->charCntExNames;
   morphCnt += ss->morphCnt;
   morphCntExNames += ss->morphCntExNames;
-  nameCnt += ss->nameCnt;
-  nameInclCnt += ss->nameInclCnt;
-  infBvCnt += ss->infBvCnt;
-  infNwCnt += ss->infNwCnt;
-  infVrijCnt += ss->infVrijCnt;
-  vdBvCnt += ss->vdBvCnt;
-  vdNwCnt += ss->vdNwCnt;
-  vdVrijCnt += ss->vdVrijCnt;
-  odBvCnt += ss->odBvCnt;
-  odNwCnt += ss->odNwCnt;
-  odVrijCnt += ss->odVrijCnt;
-  passiveCnt += ss->passiveCnt;
-  modalCnt += ss->modalCnt;
-  timeVCnt += ss->timeVCnt;
-  koppelCnt += ss->koppelCnt;
-  archaicsCnt += ss->archaicsCnt;
-  contentCnt += ss->contentCnt;
-  contentInclCnt += ss->contentInclCnt;
-  contentStrictCnt += ss->contentStrictCnt;
-  contentStrictInclCnt += ss->contentStrictInclCnt;
-  nominalCnt += ss->nominalCnt;
-  adjCnt += ss->adjCnt;
-  adjInclCnt += ss->adjInclCnt;
-  vgCnt += ss->vgCnt;
-  vnwCnt += ss->vnwCnt;
-  lidCnt += ss->lidCnt;
-  vzCnt += ss->vzCnt;
-  bwCnt += ss->bwCnt;
-  twCnt += ss->twCnt;
-  nounCnt += ss->nounCnt;
-  nounInclCnt += ss->nounInclCnt;
-  verbCnt += ss->verbCnt;
-  verbInclCnt += ss->verbInclCnt;
-  tswCnt += ss->tswCnt;
-  specCnt += ss->specCnt;
-  letCnt += ss->letCnt;
-  betrCnt += ss->betrCnt;
-  bijwCnt += ss->bijwCnt;
-  complCnt += ss->complCnt;
-  mvFinInbedCnt += ss->mvFinInbedCnt;
-  infinComplBepCnt += ss->infinComplBepCnt;
-  mvInbedCnt += ss->mvInbedCnt;
-  losBetrCnt += ss->losBetrCnt;
-  losBijwCnt += ss->losBijwCnt;
-
-  allConnCnt += ss->allConnCnt;
-  tempConnCnt += ss->tempConnCnt;
-  opsomWgConnCnt += ss->opsomWgConnCnt;
-  opsomZinConnCnt += ss->opsomZinConnCnt;
-  contrastConnCnt += ss->contrastConnCnt;
-  compConnCnt += ss->compConnCnt;
-  causeConnCnt += ss->causeConnCnt;
-
-  timeSitCnt += ss->timeSitCnt;
-  spaceSitCnt += ss->spaceSitCnt;
-  causeSitCnt += ss->causeSitCnt;
-  emoSitCnt += ss->emoSitCnt;
-  prepExprCnt += ss->prepExprCnt;
-  propNegCnt += ss->propNegCnt;
-  morphNegCnt += ss->morphNegCnt;
-  multiNegCnt += ss->multiNegCnt;
-  wordOverlapCnt += ss->wordOverlapCnt;
-  lemmaOverlapCnt += ss->lemmaOverlapCnt;
-  prevalenceP += ss->prevalenceP;
-  prevalenceZ += ss->prevalenceZ;
-  prevalenceContentP += ss->prevalenceContentP;
-  prevalenceContentZ += ss->prevalenceContentZ;
-  prevalenceCovered += ss->prevalenceCovered;
-  prevalenceContentCovered += ss->prevalenceContentCovered;
-  f50Cnt += ss->f50Cnt;
-  f65Cnt += ss->f65Cnt;
-  f77Cnt += ss->f77Cnt;
-  f80Cnt += ss->f80Cnt;
-
-  top1000Cnt += ss->top1000Cnt;
-  top2000Cnt += ss->top2000Cnt;
-  top3000Cnt += ss->top3000Cnt;
-  top5000Cnt += ss->top5000Cnt;
-  top10000Cnt += ss->top10000Cnt;
-  top20000Cnt += ss->top20000Cnt;
-  top1000ContentCnt += ss->top1000ContentCnt;
-  top2000ContentCnt += ss->top2000ContentCnt;
-  top3000ContentCnt += ss->top3000ContentCnt;
-  top5000ContentCnt += ss->top5000ContentCnt;
-  top10000ContentCnt += ss->top10000ContentCnt;
-  top20000ContentCnt += ss->top20000ContentCnt;
-  top1000ContentStrictCnt += ss->top1000ContentStrictCnt;
-  top2000ContentStrictCnt += ss->top2000ContentStrictCnt;
-  top3000ContentStrictCnt += ss->top3000ContentStrictCnt;
-  top5000ContentStrictCnt += ss->top5000ContentStrictCnt;
-  top10000ContentStrictCnt += ss->top10000ContentStrictCnt;
-  top20000ContentStrictCnt += ss->top20000ContentStrictCnt;
-
-  word_freq += ss->word_freq;
-  word_freq_n += ss->word_freq_n;
-  lemma_freq += ss->lemma_freq;
-  lemma_freq_n += ss->lemma_freq_n;
-
-  word_freq_strict += ss->word_freq_strict;
-  word_freq_n_strict += ss->word_freq_n_strict;
-  lemma_freq_strict += ss->lemma_freq_strict;
-  lemma_freq_n_strict += ss->lemma_freq_n_strict;
-
-  // Wopr forwards probabilities
-  avg_prob10_fwd += ss->avg_prob10_fwd;
-  avg_prob10_fwd_content += ss->avg_prob10_fwd_content;
-  avg_prob10_fwd_ex_names += ss->avg_prob10_fwd_ex_names;
-  avg_prob10_fwd_content_ex_names += ss->avg_prob10_fwd_content_ex_names;
-  entropy_fwd += ss->entropy_fwd;
-  entropy_fwd_norm += ss->entropy_fwd_norm;
-  perplexity_fwd += ss->perplexity_fwd;
-  perplexity_fwd_norm += ss->perplexity_fwd_norm;
-  
-  // Wopr backwards probabilities
-  avg_prob10_bwd += ss->avg_prob10_bwd;
-  avg_prob10_bwd_content += ss->avg_prob10_bwd_content;
-  avg_prob10_bwd_ex_names += ss->avg_prob10_bwd_ex_names;
-  avg_prob10_bwd_content_ex_names += ss->avg_prob10_bwd_content_ex_names;
-  entropy_bwd += ss->entropy_bwd;
-  entropy_bwd_norm += ss->entropy_bwd_norm;
-  perplexity_bwd += ss->perplexity_bwd;
-  perplexity_bwd_norm += ss->perplexity_bwd_norm;
-
-  intensCnt += ss->intensCnt;
-  intensBvnwCnt += ss->intensBvnwCnt;
-  intensBvbwCnt += ss->intensBvbwCnt;
-  intensBwCnt += ss->intensBwCnt;
-  intensCombiCnt += ss->intensCombiCnt;
-  intensNwCnt += ss->intensNwCnt;
-  intensTussCnt += ss->intensTussCnt;
-  intensWwCnt += ss->intensWwCnt;
-
-  formalCnt += ss->formalCnt;
-  formalBvnwCnt += ss->formalBvnwCnt;
-  formalBwCnt += ss->formalBwCnt;
-  formalVgwCnt += ss->formalVgwCnt;
-  formalVnwCnt += ss->formalVnwCnt;
-  formalVzCnt += ss->formalVzCnt;
-  formalVzgCnt += ss->formalVzgCnt;
-  formalWwCnt += ss->formalWwCnt;
-  formalZnwCnt += ss->formalZnwCnt;
-
-  generalNounCnt += ss->generalNounCnt;
-  generalNounSepCnt += ss->generalNounSepCnt;
-  generalNounRelCnt += ss->generalNounRelCnt;
-  generalNounActCnt += ss->generalNounActCnt;
-  generalNounKnowCnt += ss->generalNounKnowCnt;
-  generalNounDiscCnt += ss->generalNounDiscCnt;
-  generalNounDeveCnt += ss->generalNounDeveCnt;
-  generalVerbCnt += ss->generalVerbCnt;
-  generalVerbSepCnt += ss->generalVerbSepCnt;
-  generalVerbRelCnt += ss->generalVerbRelCnt;
-  generalVerbActCnt += ss->generalVerbActCnt;
-  generalVerbKnowCnt += ss->generalVerbKnowCnt;
-  generalVerbDiscCnt += ss->generalVerbDiscCnt;
-  generalVerbDeveCnt += ss->generalVerbDeveCnt;
-  generalAdverbCnt += ss->generalAdverbCnt;
-  specificAdverbCnt += ss->specificAdverbCnt;
-  smainCnt += ss->smainCnt;
-  ssubCnt += ss->ssubCnt;
-  sv1Cnt += ss->sv1Cnt;
-  clauseCnt += ss->clauseCnt;
-  correctedClauseCnt += ss->correctedClauseCnt;
-  smainCnjCnt += ss->smainCnjCnt;
-  ssubCnjCnt += ss->ssubCnjCnt;
-  sv1CnjCnt += ss->sv1CnjCnt;
-  presentCnt += ss->presentCnt;
-  pastCnt += ss->pastCnt;
-  subjonctCnt += ss->subjonctCnt;
-  pron1Cnt += ss->pron1Cnt;
-  pron2Cnt += ss->pron2Cnt;
-  pron3Cnt += ss->pron3Cnt;
-  persRefCnt += ss->persRefCnt;
-  pronRefCnt += ss->pronRefCnt;
-  strictNounCnt += ss->strictNounCnt;
-  broadNounCnt += ss->broadNounCnt;
-  strictAdjCnt += ss->strictAdjCnt;
-  broadAdjCnt += ss->broadAdjCnt;
-  subjectiveAdjCnt += ss->subjectiveAdjCnt;
-  abstractWwCnt += ss->abstractWwCnt;
-  concreteWwCnt += ss->concreteWwCnt;
-  undefinedWwCnt += ss->undefinedWwCnt;
-  undefinedATPCnt += ss->undefinedATPCnt;
-  stateCnt += ss->stateCnt;
-  actionCnt += ss->actionCnt;
-  processCnt += ss->processCnt;
-  humanAdjCnt += ss->humanAdjCnt;
-  emoAdjCnt += ss->emoAdjCnt;
-  nonhumanAdjCnt += ss->nonhumanAdjCnt;
-  shapeAdjCnt += ss->shapeAdjCnt;
-  colorAdjCnt += ss->colorAdjCnt;
-  matterAdjCnt += ss->matterAdjCnt;
-  soundAdjCnt += ss->soundAdjCnt;
-  nonhumanOtherAdjCnt += ss->nonhumanOtherAdjCnt;
-  techAdjCnt += ss->techAdjCnt;
-  timeAdjCnt += ss->timeAdjCnt;
-  placeAdjCnt += ss->placeAdjCnt;
-  specPosAdjCnt += ss->specPosAdjCnt;
-  specNegAdjCnt += ss->specNegAdjCnt;
-  posAdjCnt += ss->posAdjCnt;
-  negAdjCnt += ss->negAdjCnt;
-  evaluativeAdjCnt += ss->evaluativeAdjCnt;
-  epiPosAdjCnt += ss->epiPosAdjCnt;
-  epiNegAdjCnt += ss->epiNegAdjCnt;
-  abstractAdjCnt += ss->abstractAdjCnt;
-  undefinedNounCnt += ss->undefinedNounCnt;
-  uncoveredNounCnt += ss->uncoveredNounCnt;
-  undefinedAdjCnt += ss->undefinedAdjCnt;
-  uncoveredAdjCnt += ss->uncoveredAdjCnt;
-  uncoveredVerbCnt += ss->uncoveredVerbCnt;
-  humanCnt += ss->humanCnt;
-  nonHumanCnt += ss->nonHumanCnt;
-  artefactCnt += ss->artefactCnt;
-  concrotherCnt += ss->concrotherCnt;
-  substanceConcCnt += ss->substanceConcCnt;
-  foodcareCnt += ss->foodcareCnt;
-  timeCnt += ss->timeCnt;
-  placeCnt += ss->placeCnt;
-  measureCnt += ss->measureCnt;
-  dynamicConcCnt += ss->dynamicConcCnt;
-  substanceAbstrCnt += ss->substanceAbstrCnt;
-  dynamicAbstrCnt += ss->dynamicAbstrCnt;
-  nonDynamicCnt += ss->nonDynamicCnt;
-  institutCnt += ss->institutCnt;
-  npCnt += ss->npCnt;
-  indefNpCnt += ss->indefNpCnt;
-  npSize += ss->npSize;
-  vcModCnt += ss->vcModCnt;
-  vcModSingleCnt += ss->vcModSingleCnt;
-  adjNpModCnt += ss->adjNpModCnt;
-  npModCnt += ss->npModCnt;
-  smallCnjCnt += ss->smallCnjCnt;
-  smallCnjExtraCnt += ss->smallCnjExtraCnt;
   if ( ss->dLevel >= 0 ){
     if ( dLevel < 0 )
       dLevel = ss->dLevel;
     else
       dLevel += ss->dLevel;
   }
-  dLevel_gt4 += ss->dLevel_gt4;
-  impCnt += ss->impCnt;
-  questCnt += ss->questCnt;
-  nerCnt += ss->nerCnt;
-  compoundCnt += ss->compoundCnt;
-  compound3Cnt += ss->compound3Cnt;
-  charCntNoun += ss->charCntNoun;
-  charCntNonComp += ss->charCntNonComp;
-  charCntComp += ss->charCntComp;
-  charCntHead += ss->charCntHead;
-  charCntSat += ss->charCntSat;
-  charCntNounCorr += ss->charCntNounCorr;
-  charCntCorr += ss->charCntCorr;
-  word_freq_log_noun += ss->word_freq_log_noun;
-  word_freq_log_non_comp += ss->word_freq_log_non_comp;
-  word_freq_log_comp += ss->word_freq_log_comp;
-  word_freq_log_head += ss->word_freq_log_head;
-  word_freq_log_sat += ss->word_freq_log_sat;
-  word_freq_log_head_sat += ss->word_freq_log_head_sat;
-  word_freq_log_noun_corr += ss->word_freq_log_noun_corr;
-  word_freq_log_corr += ss->word_freq_log_corr;
-  word_freq_log_corr_strict += ss->word_freq_log_corr_strict;
-  word_freq_log_n_corr += ss->word_freq_log_n_corr;
-  word_freq_log_n_corr_strict += ss->word_freq_log_n_corr_strict;
-  top1000CntNoun += ss->top1000CntNoun;
-  top1000CntNonComp += ss->top1000CntNonComp;
-  top1000CntComp += ss->top1000CntComp;
-  top1000CntHead += ss->top1000CntHead;
-  top1000CntSat += ss->top1000CntSat;
-  top1000CntNounCorr += ss->top1000CntNounCorr;
-  top1000CntCorr += ss->top1000CntCorr;
-  top5000CntNoun += ss->top5000CntNoun;
-  top5000CntNonComp += ss->top5000CntNonComp;
-  top5000CntComp += ss->top5000CntComp;
-  top5000CntHead += ss->top5000CntHead;
-  top5000CntSat += ss->top5000CntSat;
-  top5000CntNounCorr += ss->top5000CntNounCorr;
-  top5000CntCorr += ss->top5000CntCorr;
-  top20000CntNoun += ss->top20000CntNoun;
-  top20000CntNonComp += ss->top20000CntNonComp;
-  top20000CntComp += ss->top20000CntComp;
-  top20000CntHead += ss->top20000CntHead;
-  top20000CntSat += ss->top20000CntSat;
-  top20000CntNounCorr += ss->top20000CntNounCorr;
-  top20000CntCorr += ss->top20000CntCorr;
   updateCounter(my_classification, ss->my_classification);
   sv.push_back( ss );
   aggregate( heads, ss->heads );
-  aggregate( unique_names, ss->unique_names );
-  aggregate( unique_contents, ss->unique_contents );
-  aggregate( unique_contents_strict, ss->unique_contents_strict );
-  aggregate( unique_words, ss->unique_words );
-  aggregate( unique_lemmas, ss->unique_lemmas );
-  aggregate( unique_tijd_sits, ss->unique_tijd_sits );
-  aggregate( unique_ruimte_sits, ss->unique_ruimte_sits );
-  aggregate( unique_cause_sits, ss->unique_cause_sits );
-  aggregate( unique_emotion_sits, ss->unique_emotion_sits );
-  aggregate( unique_all_conn, ss->unique_all_conn );
-  aggregate( unique_temp_conn, ss->unique_temp_conn );
-  aggregate( unique_reeks_wg_conn, ss->unique_reeks_wg_conn );
-  aggregate( unique_reeks_zin_conn, ss->unique_reeks_zin_conn );
-  aggregate( unique_contr_conn, ss->unique_contr_conn );
-  aggregate( unique_comp_conn, ss->unique_comp_conn );
-  aggregate( unique_cause_conn, ss->unique_cause_conn );
+  unique_names.merge( ss->unique_names );
+  unique_contents.merge( ss->unique_contents );
+  unique_contents_strict.merge( ss->unique_contents_strict );
+  unique_words.merge( ss->unique_words );
+  unique_lemmas.merge( ss->unique_lemmas );
+  unique_tijd_sits.merge( ss->unique_tijd_sits );
+  unique_ruimte_sits.merge( ss->unique_ruimte_sits );
+  unique_cause_sits.merge( ss->unique_cause_sits );
+  unique_emotion_sits.merge( ss->unique_emotion_sits );
+  unique_all_conn.merge( ss->unique_all_conn );
+  unique_temp_conn.merge( ss->unique_temp_conn );
+  unique_reeks_wg_conn.merge( ss->unique_reeks_wg_conn );
+  unique_reeks_zin_conn.merge( ss->unique_reeks_zin_conn );
+  unique_contr_conn.merge( ss->unique_contr_conn );
+  unique_comp_conn.merge( ss->unique_comp_conn );
+  unique_cause_conn.merge( ss->unique_cause_conn );
   aggregate( ners, ss->ners );
   aggregate( afks, ss->afks );
-  aggregate( distances, ss->distances );
+  distances.merge( ss->distances );
+  ++al_count;
+  if ( !std::isnan( ss->al_gem ) ){
+    al_gem_sum += ss->al_gem;
+  }
+  if ( !std::isnan( ss->al_max ) ){
+    al_max_sum += ss->al_max;
+  }
   al_gem = getMeanAL();
   al_max = getHighestAL();
 }
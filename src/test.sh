@@ -1,4 +1,8 @@
 #!/usr/bin/env bash
 MY_PATH=$(dirname ${BASH_SOURCE[0]})
 cd $MY_PATH/../tests
-./testall
+result=0
+./testall || result=1
+./testoptions || result=1
+./testngram || result=1
+exit $result
@@ -22,7 +22,11 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <deque>
+#include <unordered_map>
 #include <cmath>
+#include <cctype>
 #include <regex>
 #include <algorithm>
 #include <sys/types.h>
@@ -55,6 +59,16 @@
 #include "tscan/ner.h"
 #include "tscan/utils.h"
 #include "tscan/stats.h"
+#include "tscan/pipeline.h"
+#include "tscan/async.h"
+#include "tscan/memo.h"
+#include "tscan/ngram.h"
+#include "tscan/phrase.h"
+#include "tscan/mtld.h"
+#include "tscan/overlap.h"
+#include "tscan/arena.h"
+#include "tscan/corpus.h"
+#include "tscan/columnar.h"
 
 using namespace std;
 
@@ -98,8 +112,45 @@ struct tagged_classification {
   string classification;
 };
 
+const size_t cgn_tag_count = CGN::WW + 1;
+
+/// @brief what the lemma based lexicons say about a lemma. It is compiled
+/// at start-up, so classifying a word takes a single lookup.
+struct lemma_class {
+  lemma_class();
+  /// @brief the connective type, per CGN tag
+  Conn::Type conn[cgn_tag_count];
+  /// @brief the situation type, per CGN tag
+  Situation::Type sit[cgn_tag_count];
+  /// @brief on the stoplist, per CGN tag
+  bool stop[cgn_tag_count];
+  bool is_intensify;
+  Intensify::Type intensify;
+  bool is_formal;
+  Formal::Type formal;
+  General::Type general_noun;
+  bool is_general_verb;
+  General::Type general_verb;
+  const tagged_classification *my_class;
+};
+
+lemma_class::lemma_class():
+  is_intensify( false ), intensify( Intensify::NO_INTENSIFY ),
+  is_formal( false ), formal( Formal::NOT_FORMAL ),
+  general_noun( General::NO_GENERAL ),
+  is_general_verb( false ), general_verb( General::NO_GENERAL ),
+  my_class( 0 ) {
+  fill( conn, conn + cgn_tag_count, Conn::NOCONN );
+  fill( sit, sit + cgn_tag_count, Situation::NO_SIT );
+  fill( stop, stop + cgn_tag_count, false );
+}
+
 struct settingData {
   void init( const TiCC::Configuration & );
+  void fill_phrases();
+  void fill_lemma_classes();
+  /// @brief should the .csv file of this kind be written?
+  bool doCSV( csvKind what ) const { return doXfiles && csvOutputs[what]; };
   bool doAlpino;
   bool doAlpinoLookup;
   bool doAlpinoServer;
@@ -107,13 +158,24 @@ struct settingData {
   bool saveAlpinoMetadata;
   bool doWopr;
   bool doXfiles;
+  bool csvOutputs[WORD_CSV + 1];
+  bool doFolia;
+  bool corpusOutput;
+  bool columnarOutput;
   bool showProblems;
   bool sentencePerLine;
+  bool boundedMemory;
   string style;
   int rarityLevel;
   unsigned int overlapSize;
   double freq_clip;
   double mtld_threshold;
+  size_t maxBackendRequests;
+  int backendTimeout;
+  size_t sentenceCacheSize;
+  size_t maxInternedStrings;
+  NgramModel lm_fwd;
+  NgramModel lm_bwd;
   /// @brief map from tokenized sentences to Alpino XML filenames
   map<string, pair<string, int>> alpinoLookup;
   map<string, SEM::Type> adj_sem;
@@ -155,14 +217,33 @@ struct settingData {
   set<string> vzexpr2;
   set<string> vzexpr3;
   set<string> vzexpr4;
+  /// @brief the multi-word lexicons, matched on lowercased words
+  PhraseTrie word_phrases;
+  /// @brief the multi-word situations, matched on lemmas
+  PhraseTrie lemma_phrases;
   map<string, Afk::Type> afkos;
   map<string, prevalence> prevalences;
   map<CGN::Type, set<string>> stop_lemmata;
   map<string, tagged_classification> my_classification;
+  unordered_map<string, lemma_class> lemma_classes;
 };
 
 settingData settings;
 
+/// @brief the client for all backend server requests. It is created on
+/// first use, after the settings are read.
+AsyncClient &backendClient() {
+  static AsyncClient client( settings.maxBackendRequests,
+                             settings.backendTimeout );
+  return client;
+}
+
+/// @brief the .csv output for the whole corpus, if any
+CorpusWriter *corpus_csv = 0;
+/// @brief the columnar file of each table for the whole corpus, when the
+/// output is columnar and for the corpus
+ColumnarWriter *columnar_corpus[WORD_CSV + 1];
+
 string unique_filename( const string &filename, const string &extension );
 
 bool fillAlpinoLookup( map<string, pair<string, int>> &m, istream &is ) {
@@ -859,8 +940,181 @@ bool fill( map<string, tagged_classification> &my_classification, const string &
   return false;
 }
 
+/**
+ * Build the phrase tries from the multi-word lexicons. When a phrase is in
+ * more than one connective or situation list, the first list added wins.
+ */
+void settingData::fill_phrases() {
+  for ( const auto& it : intensify ) {
+    word_phrases.add( it.first, Phrase::INTENSIFY, it.second );
+  }
+  for ( const auto& it : formal ) {
+    word_phrases.add( it.first, Phrase::FORMAL, it.second );
+  }
+  for ( const auto* vz : { &vzexpr2, &vzexpr3, &vzexpr4 } ) {
+    for ( const auto& expr : *vz ) {
+      word_phrases.add( expr, Phrase::PREP_EXPR, 1 );
+    }
+  }
+  const pair<const set<string> *, Conn::Type> conns[] = {
+    { &multi_temporals, Conn::TEMPOREEL },
+    { &multi_opsommers_wg, Conn::OPSOMMEND_WG },
+    { &multi_opsommers_zin, Conn::OPSOMMEND_ZIN },
+    { &multi_contrast, Conn::CONTRASTIEF },
+    { &multi_compars, Conn::COMPARATIEF },
+    { &multi_causals, Conn::CAUSAAL } };
+  for ( const auto& conn : conns ) {
+    for ( const auto& mword : *conn.first ) {
+      word_phrases.add( mword, Phrase::CONNECTIVE, conn.second );
+    }
+  }
+  const string neg_long[] = { "afgezien van", "zomin als", "met uitzondering van" };
+  for ( const auto& mword : neg_long ) {
+    word_phrases.add( mword, Phrase::NEGATIVE, 1 );
+  }
+  const pair<const set<string> *, Situation::Type> sits[] = {
+    { &multi_time_sits, Situation::TIME_SIT },
+    { &multi_space_sits, Situation::SPACE_SIT },
+    { &multi_causal_sits, Situation::CAUSAL_SIT },
+    { &multi_emotion_sits, Situation::EMO_SIT } };
+  for ( const auto& sit : sits ) {
+    for ( const auto& mword : *sit.first ) {
+      lemma_phrases.add( mword, Phrase::SITUATION, sit.second );
+    }
+  }
+}
+
+/// @brief is the lemma on a tagged list, for this tag or for any tag
+static bool onList( const map<CGN::Type, set<string>> &m, CGN::Type tag,
+                    const string &lemma ) {
+  for ( const auto t : { tag, CGN::UNASS } ) {
+    auto it = m.find( t );
+    if ( it != m.end() && it->second.find( lemma ) != it->second.end() ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Compile the lemma based lexicons into one table. For every lemma on
+ * any of the lists, and every CGN tag, the lists are consulted in the
+ * order in which the word checks used to do it.
+ */
+void settingData::fill_lemma_classes() {
+  const pair<const map<CGN::Type, set<string>> *, Conn::Type> conns[] = {
+    { &temporals1, Conn::TEMPOREEL },
+    { &opsommers_wg, Conn::OPSOMMEND_WG },
+    { &opsommers_zin, Conn::OPSOMMEND_ZIN },
+    { &contrast1, Conn::CONTRASTIEF },
+    { &compars1, Conn::COMPARATIEF },
+    { &causals1, Conn::CAUSAAL } };
+  const pair<const map<CGN::Type, set<string>> *, Situation::Type> sits[] = {
+    { &time_sits, Situation::TIME_SIT },
+    { &causal_sits, Situation::CAUSAL_SIT },
+    { &space_sits, Situation::SPACE_SIT },
+    { &emotion_sits, Situation::EMO_SIT } };
+  set<string> lemmas;
+  for ( const auto &conn : conns ) {
+    for ( const auto &it : *conn.first ) {
+      lemmas.insert( it.second.begin(), it.second.end() );
+    }
+  }
+  for ( const auto &sit : sits ) {
+    for ( const auto &it : *sit.first ) {
+      lemmas.insert( it.second.begin(), it.second.end() );
+    }
+  }
+  for ( const auto &it : stop_lemmata ) {
+    lemmas.insert( it.second.begin(), it.second.end() );
+  }
+  for ( const auto &it : intensify ) {
+    lemmas.insert( it.first );
+  }
+  for ( const auto &it : general_nouns ) {
+    lemmas.insert( it.first );
+  }
+  for ( const auto &it : general_verbs ) {
+    lemmas.insert( it.first );
+  }
+  for ( const auto &it : my_classification ) {
+    lemmas.insert( it.first );
+  }
+  // findInflected() also finds a formal word with a suffix added or
+  // removed, so include all those forms
+  for ( const auto &it : formal ) {
+    lemmas.insert( it.first );
+    for ( const auto &suffix : suffixesArray ) {
+      lemmas.insert( it.first + suffix );
+      if ( it.first.size() >= suffix.size()
+           && it.first.compare( it.first.size() - suffix.size(),
+                                suffix.size(), suffix ) == 0 ) {
+        lemmas.insert( it.first.substr( 0, it.first.size() - suffix.size() ) );
+      }
+    }
+  }
+  for ( const auto &lemma : lemmas ) {
+    lemma_class &lc = lemma_classes[lemma];
+    for ( size_t t = 0; t < cgn_tag_count; ++t ) {
+      CGN::Type tag = CGN::Type( t );
+      if ( tag == CGN::VG || tag == CGN::VZ || tag == CGN::BW ) {
+        for ( const auto &conn : conns ) {
+          if ( onList( *conn.first, tag, lemma ) ) {
+            lc.conn[t] = conn.second;
+            break;
+          }
+        }
+      }
+      for ( const auto &sit : sits ) {
+        if ( onList( *sit.first, tag, lemma ) ) {
+          lc.sit[t] = sit.second;
+          break;
+        }
+      }
+      lc.stop[t] = onList( stop_lemmata, tag, lemma );
+    }
+    auto iit = intensify.find( lemma );
+    if ( iit != intensify.end() ) {
+      lc.is_intensify = true;
+      lc.intensify = iit->second;
+    }
+    auto fit = findInflected( formal, lemma );
+    if ( fit != formal.end() ) {
+      lc.is_formal = true;
+      lc.formal = fit->second;
+    }
+    auto nit = general_nouns.find( lemma );
+    if ( nit != general_nouns.end() ) {
+      lc.general_noun = nit->second;
+    }
+    auto vit = general_verbs.find( lemma );
+    if ( vit != general_verbs.end() ) {
+      lc.is_general_verb = true;
+      lc.general_verb = vit->second;
+    }
+    auto cit = my_classification.find( lemma );
+    if ( cit != my_classification.end() ) {
+      lc.my_class = &cit->second;
+    }
+  }
+}
+
+/// @brief the compiled lexicon information for a lemma
+const lemma_class &lemmaClass( const string &lemma ) {
+  static const lemma_class none;
+  auto it = settings.lemma_classes.find( lemma );
+  if ( it == settings.lemma_classes.end() ) {
+    return none;
+  }
+  return it->second;
+}
+
 void settingData::init( const TiCC::Configuration &cf ) {
   doXfiles = true;
+  fill( csvOutputs, csvOutputs + WORD_CSV + 1, true );
+  doFolia = true;
+  corpusOutput = false;
+  columnarOutput = false;
   doAlpino = false;
   doAlpinoServer = false;
   string val = cf.lookUp( "useAlpinoServer" );
@@ -911,6 +1165,14 @@ void settingData::init( const TiCC::Configuration &cf ) {
       exit( EXIT_FAILURE );
     }
   }
+  boundedMemory = false;
+  val = cf.lookUp( "boundedMemory" );
+  if ( !val.empty() ) {
+    if ( !TiCC::stringTo( val, boundedMemory ) ) {
+      cerr << "invalid value for 'boundedMemory' in config file" << endl;
+      exit( EXIT_FAILURE );
+    }
+  }
   sentencePerLine = false;
   val = cf.lookUp( "sentencePerLine" );
   if ( !val.empty() ) {
@@ -956,6 +1218,56 @@ void settingData::init( const TiCC::Configuration &cf ) {
     cerr << "invalid value for 'frequencyClip' in config file" << endl;
     exit( EXIT_FAILURE );
   }
+  val = cf.lookUp( "maxBackendRequests" );
+  if ( val.empty() ) {
+    maxBackendRequests = 64;
+  }
+  else if ( !TiCC::stringTo( val, maxBackendRequests )
+            || maxBackendRequests < 1 ) {
+    cerr << "invalid value for 'maxBackendRequests' in config file" << endl;
+    exit( EXIT_FAILURE );
+  }
+  val = cf.lookUp( "backendTimeout" );
+  if ( val.empty() ) {
+    backendTimeout = 600;
+  }
+  else if ( !TiCC::stringTo( val, backendTimeout ) || backendTimeout < 0 ) {
+    cerr << "invalid value for 'backendTimeout' in config file" << endl;
+    exit( EXIT_FAILURE );
+  }
+  val = cf.lookUp( "sentenceCacheSize" );
+  if ( val.empty() ) {
+    sentenceCacheSize = 10000;
+  }
+  else if ( !TiCC::stringTo( val, sentenceCacheSize ) ) {
+    cerr << "invalid value for 'sentenceCacheSize' in config file" << endl;
+    exit( EXIT_FAILURE );
+  }
+  val = cf.lookUp( "maxInternedStrings" );
+  if ( val.empty() ) {
+    maxInternedStrings = 5000000;
+  }
+  else if ( !TiCC::stringTo( val, maxInternedStrings ) ) {
+    cerr << "invalid value for 'maxInternedStrings' in config file" << endl;
+    exit( EXIT_FAILURE );
+  }
+  word_ids.setLimit( maxInternedStrings );
+
+  // in-process language models, replacing the Wopr servers
+  for ( const auto &type : { "fwd", "bwd" } ) {
+    val = cf.lookUp( type, "ngram" );
+    if ( !val.empty() ) {
+      string message;
+      NgramModel &lm = ( string( type ) == "fwd" ? lm_fwd : lm_bwd );
+      if ( !lm.load( cf.configDir() + "/" + val, string( type ) == "bwd", message ) ) {
+        cerr << "unable to load the " << type << " language model: " << message << endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+  }
+  if ( !doWopr && ( lm_fwd.loaded() || lm_bwd.loaded() ) ) {
+    cerr << "the language models of the ngram section are only used with useWopr=1" << endl;
+  }
 
   val = cf.lookUp( "alpino_lookup" );
   if ( !val.empty() ) {
@@ -1116,6 +1428,8 @@ void settingData::init( const TiCC::Configuration &cf ) {
     if ( !fill( my_classification, val ) ) // full path necessary to allow custom input
       exit( EXIT_FAILURE );
   }
+  fill_phrases();
+  fill_lemma_classes();
 }
 
 inline void usage() {
@@ -1125,135 +1439,204 @@ inline void usage() {
   cerr << "\t--config=<file>   read configuration from 'file' " << endl;
   cerr << "\t-V or --version   show version " << endl;
   cerr << "\t-n                assume input file to hold one sentence per line" << endl;
+  cerr << "\t--bounded         write and free each paragraph as soon as it is analysed" << endl;
   cerr << "\t--skip=[aclw]     skip Alpino (a), CSV output (c) or Wopr (w).\n";
+  cerr << "\t--outputs=<list>  only write the outputs in the comma separated 'list' of\n"
+       << "\t                  folia, doc, par, sent and word (default all)" << endl;
+  cerr << "\t--corpus=<prefix> write the CSV output of all files to 'prefix'.document.csv,\n"
+       << "\t                  'prefix'.paragraphs.csv etc. instead of per file" << endl;
+  cerr << "\t--shardsize=<n>   start a new corpus CSV file after about 'n' MB, or 'n'\n"
+       << "\t                  KB or bytes with a K or B suffix, e.g. 500K" << endl;
+  cerr << "\t--columnar        write the CSV output in a columnar binary format instead\n"
+       << "\t                  (.tscol files with typed columns)" << endl;
   cerr << "\t-S or --stdin     read the filenames from STDIN, end the process by passing a single dot .\n";
   cerr << "\t-t <file>         process the 'file'. (deprecated)" << endl;
+  cerr << "\t--frogworkers=<n>   number of documents sent to Frog simultaneously (default 1)" << endl;
+  cerr << "\t--outputworkers=<n> number of documents written simultaneously (default 1)" << endl;
+  cerr << "\t--queuesize=<n>     maximum number of documents waiting between two stages (default 2)" << endl;
+  cerr << "\t--memreport        report the memory used for the analysis of each document" << endl;
   cerr << endl;
 }
 
-Conn::Type wordStats::checkConnective() const {
-  if ( tag != CGN::VG && tag != CGN::VZ && tag != CGN::BW )
-    return Conn::NOCONN;
+Conn::Type wordStats::checkConnective( const lemma_class &lc ) const {
+  return lc.conn[tag];
+}
 
-  if ( settings.temporals1[tag].find( lemma )
-       != settings.temporals1[tag].end() )
-    return Conn::TEMPOREEL;
-  else if ( settings.temporals1[CGN::UNASS].find( lemma )
-            != settings.temporals1[CGN::UNASS].end() )
-    return Conn::TEMPOREEL;
+Situation::Type wordStats::checkSituation( const lemma_class &lc ) const {
+  return lc.sit[tag];
+}
 
-  else if ( settings.opsommers_wg[tag].find( lemma )
-            != settings.opsommers_wg[tag].end() )
-    return Conn::OPSOMMEND_WG;
-  else if ( settings.opsommers_wg[CGN::UNASS].find( lemma )
-            != settings.opsommers_wg[CGN::UNASS].end() )
-    return Conn::OPSOMMEND_WG;
+/// @brief interpret the reply of the compound splitter
+/// @param result the comma separated parts
+/// @return the noun info
+noun parseCompound( const string &result ) {
+  noun n;
+  vector<string> parts;
+  int size = TiCC::split_at( result, parts, "," );
+  if ( size > 1 ) {
+    n.is_compound = true;
+    n.head = parts[size - 1];
+    n.compound_parts = size;
 
-  else if ( settings.opsommers_zin[tag].find( lemma )
-            != settings.opsommers_zin[tag].end() )
-    return Conn::OPSOMMEND_ZIN;
-  else if ( settings.opsommers_zin[CGN::UNASS].find( lemma )
-            != settings.opsommers_zin[CGN::UNASS].end() )
-    return Conn::OPSOMMEND_ZIN;
+    string sat = "";
+    for ( size_t i = 0; i != size - 1; ++i ) {
+      sat = sat + parts[i];
+    }
 
-  else if ( settings.contrast1[tag].find( lemma )
-            != settings.contrast1[tag].end() )
-    return Conn::CONTRASTIEF;
-  else if ( settings.contrast1[CGN::UNASS].find( lemma )
-            != settings.contrast1[CGN::UNASS].end() )
-    return Conn::CONTRASTIEF;
+    n.satellite_clean = sat;
+  }
+  else {
+    n.is_compound = false;
+  }
+  return n;
+}
 
-  else if ( settings.compars1[tag].find( lemma )
-            != settings.compars1[tag].end() )
-    return Conn::COMPARATIEF;
-  else if ( settings.compars1[CGN::UNASS].find( lemma )
-            != settings.compars1[CGN::UNASS].end() )
-    return Conn::COMPARATIEF;
+shared_future<string> requestCompound( const string &word ) {
+  string host = config.lookUp( "host", "compound_splitter" );
+  string port = config.lookUp( "port", "compound_splitter" );
+  string method = config.lookUp( "method", "compound_splitter" );
+  return backendClient().request( host, port, word + "," + method,
+                                  AsyncClient::FIRST_LINE );
+}
 
-  else if ( settings.causals1[tag].find( lemma )
-            != settings.causals1[tag].end() )
-    return Conn::CAUSAAL;
-  else if ( settings.causals1[CGN::UNASS].find( lemma )
-            != settings.causals1[CGN::UNASS].end() )
-    return Conn::CAUSAAL;
+/// @brief the splits by the compound splitter, and the lemmas of the
+/// compound heads, kept across documents and runs (see memoCacheDir)
+MemoCache compound_memo( "compound" );
+MemoCache lemma_memo( "lemma" );
 
-  return Conn::NOCONN;
+noun splitCompound( const string &word ) {
+  string result;
+  if ( compound_memo.lookup( word, result ) ) {
+    return parseCompound( result );
+  }
+  cerr << "calling compound splitter for " << word << endl;
+  string message;
+  if ( !getReply( requestCompound( word ), result, message ) ) {
+    cerr << "failed to open compound splitter connection: "
+         << config.lookUp( "host", "compound_splitter" ) << ":"
+         << config.lookUp( "port", "compound_splitter" ) << endl;
+    cerr << "Reason: " << message << endl;
+    return noun();
+  }
+  cerr << " -> " << result << endl;
+  compound_memo.store( word, result );
+  return parseCompound( result );
 }
 
-Situation::Type wordStats::checkSituation() const {
-  if ( settings.time_sits[tag].find( lemma )
-       != settings.time_sits[tag].end() ) {
-    return Situation::TIME_SIT;
-  }
-  else if ( settings.time_sits[CGN::UNASS].find( lemma )
-            != settings.time_sits[CGN::UNASS].end() ) {
-    return Situation::TIME_SIT;
-  }
-  else if ( settings.causal_sits[tag].find( lemma )
-            != settings.causal_sits[tag].end() ) {
-    return Situation::CAUSAL_SIT;
+/// @brief the compound splits and re-lemmatized heads of the unknown nouns
+/// in the current document, as found by splitCompounds()
+struct compound_batch {
+  map<string, noun> splits;
+  map<string, string> head_lemmas;
+};
+
+compound_batch compounds;
+
+/// @brief Split all unknown nouns of a document in one go.
+/// Every distinct noun lemma that is not in the noun lexicon is sent to the
+/// compound splitter, all requests in flight at the same time. The heads
+/// that are still unknown are then re-lemmatized in one Frog request.
+/// wordStats::checkNoun() picks up the results.
+/// @param words all words of the document
+void splitCompounds( const vector<folia::Word *> &words ) {
+  compounds.splits.clear();
+  compounds.head_lemmas.clear();
+  if ( config.lookUp( "useCompoundSplitter" ) != "1" ) {
+    return;
   }
-  else if ( settings.causal_sits[CGN::UNASS].find( lemma )
-            != settings.causal_sits[CGN::UNASS].end() ) {
-    return Situation::CAUSAL_SIT;
+  map<string, shared_future<string>> pending;
+  for ( const auto &w : words ) {
+    vector<folia::PosAnnotation *> posV = w->select<folia::PosAnnotation>( frog_pos_set );
+    if ( posV.size() != 1 || CGN::toCGN( posV[0]->feat( "head" ) ) != CGN::N ) {
+      continue;
+    }
+    string lemma = w->lemma( frog_lemma_set );
+    if ( pending.find( lemma ) == pending.end()
+         && compounds.splits.find( lemma ) == compounds.splits.end()
+         && findInflected( settings.noun_sem, lemma ) == settings.noun_sem.end() ) {
+      string result;
+      if ( compound_memo.lookup( lemma, result ) ) {
+        compounds.splits[lemma] = parseCompound( result );
+      }
+      else {
+        pending[lemma] = requestCompound( lemma );
+      }
+    }
   }
-  else if ( settings.space_sits[tag].find( lemma )
-            != settings.space_sits[tag].end() ) {
-    return Situation::SPACE_SIT;
+  if ( !pending.empty() ) {
+    cerr << "calling compound splitter for " << pending.size() << " nouns" << endl;
   }
-  else if ( settings.space_sits[CGN::UNASS].find( lemma )
-            != settings.space_sits[CGN::UNASS].end() ) {
-    return Situation::SPACE_SIT;
+  for ( const auto &it : pending ) {
+    string result;
+    string message;
+    if ( !getReply( it.second, result, message ) ) {
+      cerr << "failed to open compound splitter connection: "
+           << config.lookUp( "host", "compound_splitter" ) << ":"
+           << config.lookUp( "port", "compound_splitter" ) << endl;
+      cerr << "Reason: " << message << endl;
+      compounds.splits[it.first] = noun();
+      continue;
+    }
+    cerr << " " << it.first << " -> " << result << endl;
+    compound_memo.store( it.first, result );
+    compounds.splits[it.first] = parseCompound( result );
+  }
+  vector<string> heads;
+  for ( const auto &it : compounds.splits ) {
+    const noun &n = it.second;
+    string head_lemma;
+    if ( !n.is_compound
+         || findInflected( settings.noun_sem, n.head ) != settings.noun_sem.end()
+         || compounds.head_lemmas.find( n.head ) != compounds.head_lemmas.end()
+         || find( heads.begin(), heads.end(), n.head ) != heads.end() ) {
+      continue;
+    }
+    if ( lemma_memo.lookup( n.head, head_lemma ) ) {
+      compounds.head_lemmas[n.head] = head_lemma;
+    }
+    else {
+      heads.push_back( n.head );
+    }
   }
-  else if ( settings.emotion_sits[tag].find( lemma )
-            != settings.emotion_sits[tag].end() ) {
-    return Situation::EMO_SIT;
+  if ( heads.empty() ) {
+    return;
   }
-  else if ( settings.emotion_sits[CGN::UNASS].find( lemma )
-            != settings.emotion_sits[CGN::UNASS].end() ) {
-    return Situation::EMO_SIT;
+  // every head is sent as a separate sentence
+  string request;
+  for ( const auto &head : heads ) {
+    request += head + "\n\n";
   }
-  return Situation::NO_SIT;
-}
-
-noun splitCompound( const string &word ) {
-  noun n;
-  // open connection
-  string host = config.lookUp( "host", "compound_splitter" );
-  string port = config.lookUp( "port", "compound_splitter" );
-  string method = config.lookUp( "method", "compound_splitter" );
-  Sockets::ClientSocket client;
-  if ( !client.connect( host, port ) ) {
-    cerr << "failed to open compound splitter connection: " << host << ":" << port << endl;
-    cerr << "Reason: " << client.getMessage() << endl;
+  string result;
+  string message;
+  if ( !getReply( backendClient().request( config.lookUp( "host", "frog" ),
+                                           config.lookUp( "port", "frog" ),
+                                           request + "EOT\n",
+                                           AsyncClient::MARKER_LINE, "READY" ),
+                  result, message ) ) {
+    cerr << "failed to open Frog connection: " << message << endl;
+    return;
   }
-  else {
-    cerr << "calling compound splitter for " << word << endl;
-    client.write( word + "," + method );
-    string result;
-    client.read( result );
-    cerr << " -> " << result << endl;
-
-    // store result in noun struct
-    vector<string> parts;
-    int size = TiCC::split_at( result, parts, "," );
-    if ( size > 1 ) {
-      n.is_compound = true;
-      n.head = parts[size - 1];
-      n.compound_parts = size;
-
-      string sat = "";
-      for ( size_t i = 0; i != size - 1; ++i ) {
-        sat = sat + parts[i];
+  try {
+    folia::Document doc;
+    doc.readFromString( result );
+    vector<folia::Sentence *> sents = doc.sentences();
+    if ( sents.size() != heads.size() ) {
+      // the heads didn't come back one per sentence, leave them to
+      // lemmatize()
+      return;
+    }
+    for ( size_t i = 0; i < heads.size(); ++i ) {
+      vector<folia::Word *> wv = sents[i]->words();
+      if ( !wv.empty() ) {
+        compounds.head_lemmas[heads[i]] = wv[0]->lemma();
+        lemma_memo.store( heads[i], wv[0]->lemma() );
       }
-
-      n.satellite_clean = sat;
-    }
-    else {
-      n.is_compound = false;
     }
   }
-  return n;
+  catch ( std::exception &e ) {
+    cerr << "Frog parsing failed:" << endl
+         << e.what() << endl;
+  }
 }
 
 // finds the probable word form of the head of a compounded lemma
@@ -1296,30 +1679,28 @@ string formForHead( const string &complete_word, const string &head_lemma ) {
 }
 
 string lemmatize( const string &word ) {
+  string result;
+  if ( lemma_memo.lookup( word, result ) ) {
+    return result;
+  }
   string host = config.lookUp( "host", "frog" );
   string port = config.lookUp( "port", "frog" );
-  Sockets::ClientSocket client;
-  if ( !client.connect( host, port ) ) {
+  string message;
+  if ( !getReply( backendClient().request( host, port, word + "\nEOT\n",
+                                           AsyncClient::MARKER_LINE, "READY" ),
+                  result, message ) ) {
     cerr << "failed to open Frog connection: " << host << ":" << port << endl;
-    cerr << "Reason: " << client.getMessage() << endl;
+    cerr << "Reason: " << message << endl;
     return word;
   }
 
-  client.write( word + "\nEOT\n" );
-  string result;
-  string s;
-  while ( client.read( s ) ) {
-    if ( s == "READY" )
-      break;
-    result += s + "\n";
-  }
-
   if ( !result.empty() && result.size() > min_file_length ) {
-    folia::Document *doc;
-    doc = new folia::Document();
+    folia::Document doc;
     try {
-      doc->readFromString( result );
-      return doc->words()[0]->lemma();
+      doc.readFromString( result );
+      string lemma = doc.words()[0]->lemma();
+      lemma_memo.store( word, lemma );
+      return lemma;
     }
     catch ( std::exception &e ) {
       cerr << "Frog parsing failed:" << endl
@@ -1356,7 +1737,14 @@ void wordStats::checkNoun() {
       bool found_split = false;
       if ( config.lookUp( "useCompoundSplitter" ) == "1" ) {
         // lemmatization is already done by Frog
-        noun n = splitCompound( lemma );
+        noun n;
+        auto bit = compounds.splits.find( lemma );
+        if ( bit != compounds.splits.end() ) {
+          n = bit->second;
+        }
+        else {
+          n = splitCompound( lemma );
+        }
         if ( n.is_compound ) {
           is_compound = n.is_compound;
           compound_parts = n.compound_parts;
@@ -1370,7 +1758,14 @@ void wordStats::checkNoun() {
           // retry lemmatization just this head
           if ( sit == settings.noun_sem.end() ) {
             cerr << " re-lemmatize head using Frog:";
-            string head_lemma = lemmatize( n.head );
+            string head_lemma;
+            auto hit = compounds.head_lemmas.find( n.head );
+            if ( hit != compounds.head_lemmas.end() ) {
+              head_lemma = hit->second;
+            }
+            else {
+              head_lemma = lemmatize( n.head );
+            }
             cerr << " " << n.head << " -> " << head_lemma << endl;
             sit = findInflected( settings.noun_sem, head_lemma );
           }
@@ -1464,20 +1859,21 @@ SEM::Type wordStats::checkSemProps() const {
 }
 
 // Looks up the Intensity type for a word, or NO_INTENSIFY if not found
-Intensify::Type wordStats::checkIntensify( const xmlNode *alpWord ) const {
+Intensify::Type wordStats::checkIntensify( const xmlNode *alpWord,
+                                           const lemma_class &lc ) const {
   Intensify::Type res = Intensify::NO_INTENSIFY;
 
   // First check the full lemma (if available), then the normal lemma
-  map<string, Intensify::Type>::const_iterator sit = settings.intensify.end();
-  if ( !full_lemma.empty() ) {
-    sit = settings.intensify.find( full_lemma );
+  const lemma_class *found = 0;
+  if ( !full_lemma.empty() && lemmaClass( full_lemma ).is_intensify ) {
+    found = &lemmaClass( full_lemma );
   }
-  if ( sit == settings.intensify.end() ) {
-    sit = settings.intensify.find( lemma );
+  else if ( lc.is_intensify ) {
+    found = &lc;
   }
 
-  if ( sit != settings.intensify.end() ) {
-    res = sit->second;
+  if ( found ) {
+    res = found->intensify;
 
     // Special case for BVBW: check if this is not a modifier
     if ( res == Intensify::BVBW ) {
@@ -1488,50 +1884,30 @@ Intensify::Type wordStats::checkIntensify( const xmlNode *alpWord ) const {
 }
 
 // Looks up the Formal type for a word, or NOT_FORMAL if not found
-Formal::Type wordStats::checkFormal() const {
-  Formal::Type res = Formal::NOT_FORMAL;
-
+Formal::Type wordStats::checkFormal( const lemma_class &lc ) const {
   // First check the full lemma (if available), then the normal lemma
-  map<string, Formal::Type>::const_iterator sit = settings.formal.end();
-  if ( !full_lemma.empty() ) {
-    sit = findInflected( settings.formal, full_lemma );
-  }
-  if ( sit == settings.formal.end() ) {
-    sit = findInflected( settings.formal, lemma );
-  }
-
-  if ( sit != settings.formal.end() ) {
-    res = sit->second;
+  if ( !full_lemma.empty() && lemmaClass( full_lemma ).is_formal ) {
+    return lemmaClass( full_lemma ).formal;
   }
-  return res;
+  return lc.formal;
 }
 
 // Looks up the General type for a noun (based on lemma), or NO_GENERAL if not found
-General::Type wordStats::checkGeneralNoun() const {
+General::Type wordStats::checkGeneralNoun( const lemma_class &lc ) const {
   if ( tag == CGN::N ) {
-    map<string, General::Type>::const_iterator sit = settings.general_nouns.find( lemma );
-    if ( sit != settings.general_nouns.end() ) {
-      return sit->second;
-    }
+    return lc.general_noun;
   }
   return General::NO_GENERAL;
 }
 
 // Looks up the General type for a verb (based on (full) lemma), or NO_GENERAL if not found
-General::Type wordStats::checkGeneralVerb() const {
+General::Type wordStats::checkGeneralVerb( const lemma_class &lc ) const {
   if ( tag == CGN::WW ) {
     // First check the full lemma (if available), then the normal lemma
-    map<string, General::Type>::const_iterator sit = settings.general_verbs.end();
-    if ( !full_lemma.empty() ) {
-      sit = settings.general_verbs.find( full_lemma );
-    }
-    if ( sit == settings.general_verbs.end() ) {
-      sit = settings.general_verbs.find( lemma );
-    }
-
-    if ( sit != settings.general_verbs.end() ) {
-      return sit->second;
+    if ( !full_lemma.empty() && lemmaClass( full_lemma ).is_general_verb ) {
+      return lemmaClass( full_lemma ).general_verb;
     }
+    return lc.general_verb;
   }
   return General::NO_GENERAL;
 }
@@ -1567,31 +1943,19 @@ Afk::Type wordStats::checkAfk() const {
 }
 
 // Returns the self-defined classification for a lemma (if its tag is correct)
-string wordStats::checkMyClassification() const {
+string wordStats::checkMyClassification( const lemma_class &lc ) const {
   string result;
-  map<string, tagged_classification>::const_iterator sit = settings.my_classification.find( lemma );
-  if ( sit != settings.my_classification.end() ) {
-    tagged_classification tc = sit->second;
-    if ( tc.tag == CGN::UNASS || tc.tag == tag ) {
-      result = tc.classification;
+  if ( lc.my_class ) {
+    if ( lc.my_class->tag == CGN::UNASS || lc.my_class->tag == tag ) {
+      result = lc.my_class->classification;
     }
   }
   return result;
 }
 
 // Returns whether the lemma appears on the stoplist
-bool wordStats::checkStoplist() const {
-  bool result = false;
-
-  if ( settings.stop_lemmata[tag].find( lemma )
-       != settings.stop_lemmata[tag].end() ) {
-    result = true;
-  }
-  else if ( settings.stop_lemmata[CGN::UNASS].find( lemma )
-            != settings.stop_lemmata[CGN::UNASS].end() ) {
-    result = true;
-  }
-  return result;
+bool wordStats::checkStoplist( const lemma_class &lc ) const {
+  return lc.stop[tag];
 }
 
 // Returns the position of a word in the top-20000 lexicon
@@ -1666,20 +2030,71 @@ void wordStats::staphFreqLookup() {
   }
 }
 
+static const string pos_feature_names[POS_FEATURE_COUNT] = {
+  "wvorm", "positie", "pvtijd", "vwtype", "naamval", "persoon", "conjtype" };
+
+/// @brief read the Frog annotation of all words of a sentence
+/// @param s the sentence
+/// @param w the words of the sentence
+sentenceAnnotations::sentenceAnnotations( const folia::Sentence *s,
+                                          const vector<folia::Word *> &w ) :
+    text( w.size() ), has_pos( w.size(), false ), pos( w.size() ),
+    tag( w.size(), CGN::UNASS ), features( w.size() ), lemma( w.size() ),
+    morphs( w.size() ), compounds( w.size() ) {
+  unordered_map<const folia::FoliaElement *, int> positions;
+  for ( size_t i = 0; i < w.size(); ++i ) {
+    positions[w[i]] = i;
+    text[i] = w[i]->text();
+    vector<folia::PosAnnotation *> posV = w[i]->select<folia::PosAnnotation>( frog_pos_set );
+    if ( posV.size() != 1 ) {
+      // only an error when the analysis needs it
+      continue;
+    }
+    folia::PosAnnotation *pa = posV[0];
+    has_pos[i] = true;
+    pos[i] = pa->cls();
+    tag[i] = CGN::toCGN( pa->feat( "head" ) );
+    for ( size_t f = 0; f < POS_FEATURE_COUNT; ++f ) {
+      features[i][f] = pa->feat( pos_feature_names[f] );
+    }
+    lemma[i] = w[i]->lemma( frog_lemma_set );
+    if ( tag[i] != CGN::LET ) {
+      morphs[i] = get_full_morph_analysis( w[i], true );
+      compounds[i] = get_compound_analysis( w[i] );
+    }
+  }
+  vector<folia::Chunk *> cv = s->select<folia::Chunk>();
+  for ( size_t i = 0; i < cv.size(); ++i ) {
+    if ( cv[i]->cls() == "NP" ) {
+      np_sizes.push_back( cv[i]->size() );
+      int first = -1;
+      folia::FoliaElement *det = cv[i]->index( 0 );
+      if ( det ) {
+        auto it = positions.find( det );
+        if ( it != positions.end() ) {
+          first = it->second;
+        }
+      }
+      np_firsts.push_back( first );
+    }
+  }
+}
+
+void sentenceAnnotations::checkPos( size_t i ) const {
+  if ( !has_pos[i] )
+    throw folia::ValueError( "word doesn't have Frog POS tag info" );
+}
+
 wordStats::wordStats( int index,
                       folia::Word *w,
+                      const sentenceAnnotations &ann,
                       const xmlNode *alpWord,
                       const set<size_t> &puncts,
                       bool fail ) :
     basicStats( index, w, "word" ),
-    parseFail( fail ), wwform( ::NO_VERB ),
-    isPersRef( false ), isPronRef( false ),
-    archaic( false ), isContent( false ), isContentStrict( false ),
-    isNominal( false ), isOnder( false ), isImperative( false ),
-    isBetr( false ), isPropNeg( false ), isMorphNeg( false ),
-    nerProp( NER::NONER ), connType( Conn::NOCONN ), isMultiConn( false ), sitType( Situation::NO_SIT ),
+    wwform( ::NO_VERB ),
+    nerProp( NER::NONER ), connType( Conn::NOCONN ), sitType( Situation::NO_SIT ),
     prevalenceP( NAN ), prevalenceZ( NAN ),
-    f50( false ), f65( false ), f77( false ), f80( false ),
     top_freq( notFound ), word_freq( 0 ), lemma_freq( 0 ),
     wordOverlapCnt( 0 ), lemmaOverlapCnt( 0 ),
     word_freq_log( NAN ), lemma_freq_log( NAN ),
@@ -1689,27 +2104,33 @@ wordStats::wordStats( int index,
     formal_type( Formal::NOT_FORMAL ),
     general_noun_type( General::NO_GENERAL ), general_verb_type( General::NO_GENERAL ),
     adverb_type( Adverb::NO_ADVERB ), adverb_sub_type( Adverb::NO_ADVERB_SUBTYPE ),
-    afkType( Afk::NO_A ), is_compound( false ), compound_parts( 0 ),
-    word_freq_log_head( NAN ), word_freq_log_sat( NAN ), word_freq_log_head_sat( NAN ), word_freq_log_corr( NAN ), on_stoplist( false ) {
-  icu::UnicodeString us = w->text();
+    afkType( Afk::NO_A ), compound_parts( 0 ),
+    word_freq_log_head( NAN ), word_freq_log_sat( NAN ), word_freq_log_head_sat( NAN ), word_freq_log_corr( NAN ),
+    parseFail( fail ), isPersRef( false ), isPronRef( false ),
+    archaic( false ), isContent( false ), isContentStrict( false ),
+    isNominal( false ), isOnder( false ), isImperative( false ),
+    isBetr( false ), isPropNeg( false ), isMorphNeg( false ), isMultiConn( false ),
+    f50( false ), f65( false ), f77( false ), f80( false ),
+    is_compound( false ), on_stoplist( false ) {
+  icu::UnicodeString us = ann.text[index];
   charCnt = us.length();
   word = TiCC::UnicodeToUTF8( us );
   l_word = TiCC::UnicodeToUTF8( us.toLower() );
   if ( fail )
     return;
-  vector<folia::PosAnnotation *> posV = w->select<folia::PosAnnotation>( frog_pos_set );
-  if ( posV.size() != 1 )
-    throw folia::ValueError( "word doesn't have Frog POS tag info" );
-  folia::PosAnnotation *pa = posV[0];
-  pos = pa->cls();
-  tag = CGN::toCGN( pa->feat( "head" ) );
-  lemma = w->lemma( frog_lemma_set );
+  ann.checkPos( index );
+  pos = ann.pos[index];
+  tag = ann.tag[index];
+  lemma = ann.lemma[index];
   us = TiCC::UnicodeFromUTF8( lemma );
   l_lemma = TiCC::UnicodeToUTF8( us.toLower() );
 
-  setCGNProps( pa );
+  setCGNProps( ann.features[index] );
   if ( alpWord ) {
-    distances = getDependencyDist( alpWord, puncts );
+    DistanceStats dist = getDependencyDist( alpWord, puncts );
+    if ( !dist.empty() ) {
+      distances = make_shared<const DistanceStats>( dist );
+    }
     if ( tag == CGN::WW ) {
       string full;
       wwform = classifyVerb( alpWord, lemma, full );
@@ -1724,7 +2145,7 @@ wordStats::wordStats( int index,
     }
   }
   if ( prop != CGN::ISLET ) {
-    vector<string> mv = get_full_morph_analysis( w, true );
+    const vector<string> &mv = ann.morphs[index];
     // get_full_morph_amalysis returns 1 or more morpheme sequences
     // like [appel][taart] of [veilig][heid]
     // there may be more readings/morpheme lists:
@@ -1738,7 +2159,7 @@ wordStats::wordStats( int index,
       if ( parts.size() > max ) {
         // a hack: we assume the longest morpheme list to
         // be the best choice.
-        morphemes = parts;
+        morphemes.assign( parts.begin(), parts.end() );
         max = parts.size();
         match_pos = pos;
       }
@@ -1748,7 +2169,7 @@ wordStats::wordStats( int index,
       cerr << "unable to retrieve morphemes from folia." << endl;
     }
     //    cerr << "Morphemes " << word << "= " << morphemes << endl;
-    vector<string> cmps = get_compound_analysis( w );
+    const vector<string> &cmps = ann.compounds[index];
     //    cerr << "Comps " << word << "= " << cmps << endl;
     if ( cmps.size() > match_pos ) {
       // this might not be the case e.g. when frog isn't started
@@ -1757,8 +2178,9 @@ wordStats::wordStats( int index,
     }
     isPropNeg = checkPropNeg();
     isMorphNeg = checkMorphNeg();
-    connType = checkConnective();
-    sitType = checkSituation();
+    const lemma_class &lc = lemmaClass( lemma );
+    connType = checkConnective( lc );
+    sitType = checkSituation( lc );
     morphCnt = morphemes.size();
     if ( prop != CGN::ISNAME ) {
       charCntExNames = charCnt;
@@ -1766,10 +2188,10 @@ wordStats::wordStats( int index,
     }
     sem_type = checkSemProps();
     checkNoun();
-    intensify_type = checkIntensify( alpWord );
-    formal_type = checkFormal();
-    general_noun_type = checkGeneralNoun();
-    general_verb_type = checkGeneralVerb();
+    intensify_type = checkIntensify( alpWord, lc );
+    formal_type = checkFormal( lc );
+    general_noun_type = checkGeneralNoun( lc );
+    general_verb_type = checkGeneralVerb( lc );
     adverb_type = checkAdverbType( l_word, tag );
     adverb_sub_type = checkAdverbSubType( l_word, tag );
     afkType = checkAfk();
@@ -1796,201 +2218,222 @@ wordStats::wordStats( int index,
     else {
       word_freq_log_corr = word_freq_log;
     }
-    on_stoplist = checkStoplist();
-    my_classification = checkMyClassification();
-  }
-}
-
-// #define DEBUG_MTLD
-
-double calculate_mtld( const vector<string> &v ) {
-  if ( v.size() == 0 ) {
-    return 0.0;
-  }
-  int token_count = 0;
-  set<string> unique_tokens;
-  double token_factor = 0.0;
-  for ( size_t i = 0; i < v.size(); ++i ) {
-    ++token_count;
-    unique_tokens.insert( v[i] );
-    double token_ttr = unique_tokens.size() / double( token_count );
-#ifdef DEBUG_MTLD
-    cerr << v[i] << "\t [" << unique_tokens.size() << "/"
-         << token_count << "] >> ttr " << token_ttr << endl;
-#endif
-    if ( token_ttr <= settings.mtld_threshold ) {
-#ifdef KOIZUMI
-      if ( token_count >= 10 ) {
-        token_factor += 1.0;
-      }
-#else
-      token_factor += 1.0;
-#endif
-      token_count = 0;
-      unique_tokens.clear();
-#ifdef DEBUG_MTLD
-      cerr << "\treset: token_factor = " << token_factor << endl
-           << endl;
-#endif
-    }
-    else if ( i == v.size() - 1 ) {
-#ifdef DEBUG_MTLD
-      cerr << "\trestje: huidige token_ttr= " << token_ttr;
-#endif
-      // partial result
-      double threshold = ( 1 - token_ttr ) / ( 1 - settings.mtld_threshold );
-#ifdef DEBUG_MTLD
-      cerr << " dus verhoog de factor met " << ( 1 - token_ttr )
-           << "/" << ( 1 - settings.mtld_threshold ) << endl;
-#endif
-      token_factor += threshold;
-    }
+    on_stoplist = checkStoplist( lc );
+    my_classification = checkMyClassification( lc );
   }
-  if ( token_factor == 0.0 )
-    token_factor = 1.0;
-#ifdef DEBUG_MTLD
-  cerr << "Factor = " << token_factor << " #words = " << v.size() << endl;
-#endif
-  return v.size() / token_factor;
 }
 
-double average_mtld( vector<string> &tokens ) {
-#ifdef DEBUG_MTLD
-  cerr << "bereken MTLD van " << tokens << endl;
-#endif
-  double mtld1 = calculate_mtld( tokens );
-#ifdef DEBUG_MTLD
-  cerr << "VOORUIT = " << mtld1 << endl;
-#endif
-  reverse( tokens.begin(), tokens.end() );
-  double mtld2 = calculate_mtld( tokens );
-#ifdef DEBUG_MTLD
-  cerr << "ACHTERUIT = " << mtld2 << endl;
-#endif
-  double result = ( mtld1 + mtld2 ) / 2.0;
-#ifdef DEBUG_MTLD
-  cerr << "average mtld = " << result << endl;
-#endif
-  return result;
-}
-
-void structStats::calculate_MTLDs() {
-  const vector<const wordStats *> wordNodes = collectWords();
-  vector<string> words;
-  vector<string> lemmas;
-  vector<string> conts;
-  vector<string> conts_strict;
-  vector<string> names;
-  vector<string> temp_conn;
-  vector<string> reeks_wg_conn;
-  vector<string> reeks_zin_conn;
-  vector<string> contr_conn;
-  vector<string> comp_conn;
-  vector<string> cause_conn;
-  vector<string> tijd_sits;
-  vector<string> ruimte_sits;
-  vector<string> cause_sits;
-  vector<string> emotion_sits;
-  for ( size_t i = 0; i < wordNodes.size(); ++i ) {
-    if ( wordNodes[i]->wordProperty() == CGN::ISLET ) {
+/// @brief the token series that the MTLDs are computed over
+enum { WORDS, LEMMAS, CONTS, CONTS_STRICT, NAMES,
+       TEMP_CONN, REEKS_WG_CONN, REEKS_ZIN_CONN, CONTR_CONN, COMP_CONN,
+       CAUSE_CONN, TIJD_SITS, RUIMTE_SITS, CAUSE_SITS, EMOTION_SITS,
+       ALL_CONN, MTLD_SERIES_COUNT };
+
+/// @brief add words to the MTLD series
+/// @param wordNodes the words, in text order
+/// @param series the series, MTLD_SERIES_COUNT of them
+void add_mtld_series( const word_range &wordNodes, vector<mtld_series> &series ) {
+  for ( const auto &word : wordNodes ) {
+    if ( word->wordProperty() == CGN::ISLET ) {
       continue;
     }
-    string word = wordNodes[i]->ltext();
-    words.push_back( word );
-    string lemma = wordNodes[i]->llemma();
-    lemmas.push_back( lemma );
-    if ( wordNodes[i]->isContent ) {
-      conts.push_back( wordNodes[i]->ltext() );
+    series[WORDS].push_back( word->l_word.id() );
+    series[LEMMAS].push_back( word->l_lemma.id() );
+    if ( word->isContent ) {
+      series[CONTS].push_back( word->l_word.id() );
     }
-    if ( wordNodes[i]->isContentStrict ) {
-      conts_strict.push_back( wordNodes[i]->ltext() );
+    if ( word->isContentStrict ) {
+      series[CONTS_STRICT].push_back( word->l_word.id() );
     }
-    if ( wordNodes[i]->prop == CGN::ISNAME ) {
-      names.push_back( wordNodes[i]->ltext() );
+    if ( word->prop == CGN::ISNAME ) {
+      series[NAMES].push_back( word->l_word.id() );
     }
-    switch ( wordNodes[i]->getConnType() ) {
+    switch ( word->getConnType() ) {
       case Conn::TEMPOREEL:
-        temp_conn.push_back( wordNodes[i]->ltext() );
+        series[TEMP_CONN].push_back( word->l_word.id() );
         break;
       case Conn::OPSOMMEND_WG:
-        reeks_wg_conn.push_back( wordNodes[i]->ltext() );
+        series[REEKS_WG_CONN].push_back( word->l_word.id() );
         break;
       case Conn::OPSOMMEND_ZIN:
-        reeks_zin_conn.push_back( wordNodes[i]->ltext() );
+        series[REEKS_ZIN_CONN].push_back( word->l_word.id() );
         break;
       case Conn::CONTRASTIEF:
-        contr_conn.push_back( wordNodes[i]->ltext() );
+        series[CONTR_CONN].push_back( word->l_word.id() );
         break;
       case Conn::COMPARATIEF:
-        comp_conn.push_back( wordNodes[i]->ltext() );
+        series[COMP_CONN].push_back( word->l_word.id() );
         break;
       case Conn::CAUSAAL:
-        cause_conn.push_back( wordNodes[i]->ltext() );
+        series[CAUSE_CONN].push_back( word->l_word.id() );
         break;
       default:
         break;
     }
-    switch ( wordNodes[i]->getSitType() ) {
+    switch ( word->getSitType() ) {
       case Situation::TIME_SIT:
-        tijd_sits.push_back( wordNodes[i]->Lemma() );
+        series[TIJD_SITS].push_back( word->lemma.id() );
         break;
       case Situation::CAUSAL_SIT:
-        cause_sits.push_back( wordNodes[i]->Lemma() );
+        series[CAUSE_SITS].push_back( word->lemma.id() );
         break;
       case Situation::SPACE_SIT:
-        ruimte_sits.push_back( wordNodes[i]->Lemma() );
+        series[RUIMTE_SITS].push_back( word->lemma.id() );
         break;
       case Situation::EMO_SIT:
-        emotion_sits.push_back( wordNodes[i]->Lemma() );
+        series[EMOTION_SITS].push_back( word->lemma.id() );
         break;
       default:
         break;
     }
   }
+}
 
-  word_mtld = average_mtld( words );
-  lemma_mtld = average_mtld( lemmas );
-  content_mtld = average_mtld( conts );
-  content_mtld_strict = average_mtld( conts_strict );
-  name_mtld = average_mtld( names );
-  temp_conn_mtld = average_mtld( temp_conn );
-  reeks_wg_conn_mtld = average_mtld( reeks_wg_conn );
-  reeks_zin_conn_mtld = average_mtld( reeks_zin_conn );
-  contr_conn_mtld = average_mtld( contr_conn );
-  comp_conn_mtld = average_mtld( comp_conn );
-  cause_conn_mtld = average_mtld( cause_conn );
-  tijd_sit_mtld = average_mtld( tijd_sits );
-  ruimte_sit_mtld = average_mtld( ruimte_sits );
-  cause_sit_mtld = average_mtld( cause_sits );
-  emotion_sit_mtld = average_mtld( emotion_sits );
+void structStats::calculate_MTLDs() {
+  const word_range wordNodes = words();
+  vector<mtld_series> series( MTLD_SERIES_COUNT );
+  series[WORDS].reserve( wordNodes.size() );
+  series[LEMMAS].reserve( wordNodes.size() );
+  add_mtld_series( wordNodes, series );
+  calculate_MTLDs( series );
+}
 
+/// @brief compute the MTLDs from the series of all words
+/// @param series the series, filled by add_mtld_series()
+void structStats::calculate_MTLDs( vector<mtld_series> &series ) {
   // Combined connective MLTD (but don't include reeks_wg_conn)
-  vector<string> all_conn;
-  all_conn.insert( all_conn.end(), temp_conn.begin(), temp_conn.end() );
-  all_conn.insert( all_conn.end(), reeks_zin_conn.begin(), reeks_zin_conn.end() );
-  all_conn.insert( all_conn.end(), contr_conn.begin(), contr_conn.end() );
-  all_conn.insert( all_conn.end(), comp_conn.begin(), comp_conn.end() );
-  all_conn.insert( all_conn.end(), cause_conn.begin(), cause_conn.end() );
-  all_conn_mtld = average_mtld( all_conn );
+  // The segments are added in reverse order: the original computation
+  // reversed each series in place before it combined them, and MTLD
+  // depends on the order of the tokens.
+  for ( const auto conn : { TEMP_CONN, REEKS_ZIN_CONN, CONTR_CONN,
+                            COMP_CONN, CAUSE_CONN } ) {
+    series[ALL_CONN].insert( series[ALL_CONN].end(),
+                             series[conn].rbegin(), series[conn].rend() );
+  }
+
+  const vector<double> mtld = average_mtlds( series, settings.mtld_threshold );
+  word_mtld = mtld[WORDS];
+  lemma_mtld = mtld[LEMMAS];
+  content_mtld = mtld[CONTS];
+  content_mtld_strict = mtld[CONTS_STRICT];
+  name_mtld = mtld[NAMES];
+  temp_conn_mtld = mtld[TEMP_CONN];
+  reeks_wg_conn_mtld = mtld[REEKS_WG_CONN];
+  reeks_zin_conn_mtld = mtld[REEKS_ZIN_CONN];
+  contr_conn_mtld = mtld[CONTR_CONN];
+  comp_conn_mtld = mtld[COMP_CONN];
+  cause_conn_mtld = mtld[CAUSE_CONN];
+  tijd_sit_mtld = mtld[TIJD_SITS];
+  ruimte_sit_mtld = mtld[RUIMTE_SITS];
+  cause_sit_mtld = mtld[CAUSE_SITS];
+  emotion_sit_mtld = mtld[EMOTION_SITS];
+  all_conn_mtld = mtld[ALL_CONN];
 }
 
-// #define DEBUG_WOPR
-void orderWopr( const string &type, const string &txt, vector<double> &wordProbsV,
-                double &sentProb, double &entropy, double &perplexity ) {
+/// @brief send a sentence to the Wopr server
+/// @param type fwd or bwd
+/// @param txt the tokenized sentence
+/// @return the pending reply
+shared_future<string> requestWopr( const string &type, const string &txt ) {
   string host = config.lookUp( "host_" + type, "wopr" );
   string port = config.lookUp( "port_" + type, "wopr" );
-  Sockets::ClientSocket client;
-  if ( !client.connect( host, port ) ) {
-    cerr << "failed to open Wopr connection: " << host << ":" << port << endl;
-    cerr << "Reason: " << client.getMessage() << endl;
-    exit( EXIT_FAILURE );
+  return backendClient().request( host, port, txt + "\n\n" );
+}
+
+/// @brief the Wopr scores of earlier sentences, per model
+/// (see memoCacheDir)
+MemoCache wopr_fwd_memo( "wopr_fwd" );
+MemoCache wopr_bwd_memo( "wopr_bwd" );
+
+MemoCache &woprMemo( const string &type ) {
+  return ( type == "fwd" ? wopr_fwd_memo : wopr_bwd_memo );
+}
+
+/// @brief identifies the Wopr model for 'type': the 'model_fwd' or
+/// 'model_bwd' setting, or else the server address
+string woprModel( const string &type ) {
+  string model = config.lookUp( "model_" + type, "wopr" );
+  if ( model.empty() ) {
+    model = config.lookUp( "host_" + type, "wopr" ) + "_"
+      + config.lookUp( "port_" + type, "wopr" );
+  }
+  return model;
+}
+
+/// @brief the cache key for a sentence: its tokens, separated by single
+/// spaces
+string woprKey( const string &txt ) {
+  vector<string> tokens;
+  TiCC::split_at_first_of( txt, tokens, " \t\r\n" );
+  string key;
+  for ( const auto &t : tokens ) {
+    if ( !key.empty() ) {
+      key += " ";
+    }
+    key += t;
+  }
+  return key;
+}
+
+string woprScores( const vector<double> &wordProbsV, double sentProb,
+                   double entropy, double perplexity ) {
+  ostringstream os;
+  os.precision( 17 );
+  os << sentProb << " " << entropy << " " << perplexity;
+  for ( const auto &p : wordProbsV ) {
+    os << " " << p;
+  }
+  return os.str();
+}
+
+/// @brief fill in the scores from a cache entry
+/// @return false when the entry doesn't match the sentence length
+bool fromWoprScores( const string &scores, vector<double> &wordProbsV,
+                     double &sentProb, double &entropy, double &perplexity ) {
+  vector<string> parts;
+  if ( TiCC::split_at( scores, parts, " " ) != wordProbsV.size() + 3 ) {
+    return false;
+  }
+  sentProb = strtod( parts[0].c_str(), 0 );
+  entropy = strtod( parts[1].c_str(), 0 );
+  perplexity = strtod( parts[2].c_str(), 0 );
+  for ( size_t i = 0; i < wordProbsV.size(); ++i ) {
+    wordProbsV[i] = strtod( parts[i + 3].c_str(), 0 );
+  }
+  return true;
+}
+
+// #define DEBUG_WOPR
+void orderWopr( const string &type, const string &txt, vector<double> &wordProbsV,
+                double &sentProb, double &entropy, double &perplexity,
+                shared_future<string> reply ) {
+  const NgramModel &lm = ( type == "fwd" ? settings.lm_fwd : settings.lm_bwd );
+  if ( lm.loaded() ) {
+    vector<string> words;
+    TiCC::split_at( txt, words, " " );
+    if ( words.size() == wordProbsV.size() ) {
+      lm.score( words, wordProbsV, sentProb, entropy, perplexity );
+      return;
+    }
+  }
+  string key = woprKey( txt );
+  string scores;
+  if ( woprMemo( type ).lookup( key, scores )
+       && fromWoprScores( scores, wordProbsV, sentProb, entropy, perplexity ) ) {
+    return;
   }
   cerr << "calling Wopr" << endl;
-  client.write( txt + "\n\n" );
+  if ( !reply.valid() ) {
+    reply = requestWopr( type, txt );
+  }
   string result;
-  string s;
-  while ( client.read( s ) ) {
-    result += s + "\n";
+  string message;
+  if ( !getReply( reply, result, message ) ) {
+    cerr << "failed to open Wopr connection: "
+         << config.lookUp( "host_" + type, "wopr" ) << ":"
+         << config.lookUp( "port_" + type, "wopr" ) << endl;
+    cerr << "Reason: " << message << endl;
+    exit( EXIT_FAILURE );
   }
 #ifdef DEBUG_WOPR
   cerr << "received data [" << result << "]" << endl;
@@ -2050,6 +2493,7 @@ void orderWopr( const string &type, const string &txt, vector<double> &wordProbs
           }
         }
       }
+      woprMemo( type ).store( key, woprScores( wordProbsV, sentProb, entropy, perplexity ) );
     }
     catch ( std::exception &e ) {
       cerr << "FoLiaParsing failed:" << endl
@@ -2065,7 +2509,78 @@ void orderWopr( const string &type, const string &txt, vector<double> &wordProbs
 
 xmlDoc *AlpinoLookup( folia::Sentence * );
 void AlpinoLookupAdd( folia::Sentence *, const string & );
-xmlDoc *AlpinoServerParse( folia::Sentence * );
+shared_future<string> requestAlpino( const folia::Sentence * );
+xmlDoc *AlpinoServerParse( folia::Sentence *, shared_future<string> );
+
+/// @brief the backend replies requested for a sentence before its analysis
+struct backend_replies {
+  shared_future<string> alpino;
+  shared_future<string> wopr_fwd;
+  shared_future<string> wopr_bwd;
+};
+
+/// @brief the replies for the sentences of the current document, see
+/// forgetPrefetched()
+map<const folia::Sentence *, backend_replies> prefetched;
+mutex prefetched_lock;
+
+string sentenceKey( folia::Sentence * );
+struct cached_sentence;
+extern map<string, cached_sentence *> sentence_cache;
+
+/// @brief send all sentences of a document to Alpino and Wopr at once, so
+/// the servers can work on them while we analyse the earlier sentences.
+/// @param sents the sentences
+void prefetchBackends( const vector<folia::Sentence *> &sents ) {
+  set<string> seen;
+  for ( const auto &s : sents ) {
+    if ( settings.sentenceCacheSize > 0 ) {
+      // repeated sentences will reuse an earlier analysis
+      string key = sentenceKey( s );
+      if ( sentence_cache.find( key ) != sentence_cache.end()
+           || !seen.insert( key ).second ) {
+        continue;
+      }
+    }
+    backend_replies replies;
+    string text = TiCC::UnicodeToUTF8( s->toktext() );
+    if ( settings.doAlpinoServer
+         && settings.alpinoLookup.find( text ) == settings.alpinoLookup.end() ) {
+      replies.alpino = requestAlpino( s );
+    }
+    if ( settings.doWopr ) {
+      string key = woprKey( text );
+      if ( !settings.lm_fwd.loaded() && !wopr_fwd_memo.contains( key ) ) {
+        replies.wopr_fwd = requestWopr( "fwd", text );
+      }
+      if ( !settings.lm_bwd.loaded() && !wopr_bwd_memo.contains( key ) ) {
+        replies.wopr_bwd = requestWopr( "bwd", text );
+      }
+    }
+    lock_guard<mutex> lock( prefetched_lock );
+    prefetched[s] = replies;
+  }
+}
+
+/// @brief take the prefetched replies for a sentence (if any)
+backend_replies takeReplies( const folia::Sentence *s ) {
+  backend_replies result;
+  lock_guard<mutex> lock( prefetched_lock );
+  auto it = prefetched.find( s );
+  if ( it != prefetched.end() ) {
+    result = it->second;
+    prefetched.erase( it );
+  }
+  return result;
+}
+
+/// @brief drop the prefetched replies that were not used. Called when a
+/// document is done, so a later sentence at the same address can't pick
+/// them up.
+void forgetPrefetched() {
+  lock_guard<mutex> lock( prefetched_lock );
+  prefetched.clear();
+}
 
 /// @brief Returns the filename if this does not exist or otherwise it will suffix
 /// it with a number to make sure this file is unique
@@ -2089,45 +2604,41 @@ string unique_filename( const string &filename, const string &extension ) {
   return outName;
 }
 
-void fill_word_lemma_buffers( const sentStats *ss,
-                              vector<string> &wv,
-                              vector<string> &lv ) {
-  auto bv = ss->sv;
-  for ( size_t i = 0; i < bv.size(); ++i ) {
-    wordStats *w = dynamic_cast<wordStats *>( bv[i] );
+void fill_overlap_windows( const sentStats *ss,
+                           OverlapWindow &words,
+                           OverlapWindow &lemmas ) {
+  for ( const auto& it : ss->sv ) {
+    const wordStats *w = dynamic_cast<const wordStats *>( it );
     if ( w->isOverlapCandidate() ) {
-      wv.push_back( w->l_word );
-      lv.push_back( w->l_lemma );
+      words.push( w->l_word.id() );
+      lemmas.push( w->l_lemma.id() );
     }
   }
 }
 
-void np_length( folia::Sentence *s, int &npcount, int &indefcount, int &size ) {
-  vector<folia::Chunk *> cv = s->select<folia::Chunk>();
+void np_length( const sentenceAnnotations &ann, int &npcount, int &indefcount, int &size ) {
   size = 0;
-  for ( size_t i = 0; i < cv.size(); ++i ) {
-    if ( cv[i]->cls() == "NP" ) {
-      ++npcount;
-      size += cv[i]->size();
-      folia::FoliaElement *det = cv[i]->index( 0 );
-      if ( det ) {
-        vector<folia::PosAnnotation *> posV = det->select<folia::PosAnnotation>( frog_pos_set );
-        if ( posV.size() != 1 )
-          throw folia::ValueError( "word doesn't have Frog POS tag info" );
-        if ( posV[0]->feat( "head" ) == "LID" ) {
-          if ( det->text() == "een" )
-            ++indefcount;
-        }
+  for ( size_t i = 0; i < ann.np_sizes.size(); ++i ) {
+    ++npcount;
+    size += ann.np_sizes[i];
+    int det = ann.np_firsts[i];
+    if ( det >= 0 ) {
+      ann.checkPos( det );
+      if ( ann.tag[det] == CGN::LID ) {
+        if ( ann.text[det] == "een" )
+          ++indefcount;
       }
     }
   }
 }
 
-sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const sentStats *pred ) :
+sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const sentStats *pred,
+                      StatsArena &arena, word_index &doc_words ) :
     structStats( index, s, "sent" ) {
   text = TiCC::UnicodeToUTF8( s->toktext() );
   cerr << "analyse tokenized sentence=" << text << endl;
   vector<folia::Word *> w = s->words();
+  const sentenceAnnotations annotations( s, w );
   vector<double> woprProbsV_fwd( w.size(), NAN );
   vector<double> woprProbsV_bwd( w.size(), NAN );
   double sentProb_fwd = NAN;
@@ -2139,6 +2650,7 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
   xmlDoc *alpDoc = 0;
   set<size_t> puncts;
   parseFailCnt = -1; // not parsed (yet)
+  backend_replies replies = takeReplies( s );
 #pragma omp parallel sections
   {
 #pragma omp section
@@ -2152,7 +2664,7 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
         }
         else if ( settings.doAlpinoServer ) {
           cerr << "calling Alpino Server" << endl;
-          alpDoc = AlpinoServerParse( s );
+          alpDoc = AlpinoServerParse( s, replies.alpino );
           if ( !alpDoc ) {
             cerr << "alpino parser failed!" << endl;
           }
@@ -2208,12 +2720,8 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
 
           parseFailCnt = 0; // OK
           for ( size_t i = 0; i < w.size(); ++i ) {
-            vector<folia::PosAnnotation *> posV = w[i]->select<folia::PosAnnotation>( frog_pos_set );
-            if ( posV.size() != 1 )
-              throw folia::ValueError( "word doesn't have Frog POS tag info" );
-            folia::PosAnnotation *pa = posV[0];
-            string posHead = pa->feat( "head" );
-            if ( posHead == "LET" ) {
+            annotations.checkPos( i );
+            if ( annotations.tag[i] == CGN::LET ) {
               puncts.insert( i );
             }
           }
@@ -2236,13 +2744,13 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
 #pragma omp section
     {
       if ( settings.doWopr ) {
-        orderWopr( "fwd", text, woprProbsV_fwd, sentProb_fwd, sentEntropy_fwd, sentPerplexity_fwd );
+        orderWopr( "fwd", text, woprProbsV_fwd, sentProb_fwd, sentEntropy_fwd, sentPerplexity_fwd, replies.wopr_fwd );
       }
     } // omp section
 #pragma omp section
     {
       if ( settings.doWopr ) {
-        orderWopr( "bwd", text, woprProbsV_bwd, sentProb_bwd, sentEntropy_bwd, sentPerplexity_bwd );
+        orderWopr( "bwd", text, woprProbsV_bwd, sentProb_bwd, sentEntropy_bwd, sentPerplexity_bwd, replies.wopr_bwd );
       }
     } // omp section
   } // omp sections
@@ -2250,21 +2758,22 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
   sentCnt = 1; // so only count the sentence when not failed
 
   bool question = false;
-  vector<string> wordbuffer;
-  vector<string> lemmabuffer;
+  OverlapWindow prev_words;
+  OverlapWindow prev_lemmas;
   if ( pred ) {
-    fill_word_lemma_buffers( pred, wordbuffer, lemmabuffer );
-#ifdef DEBUG_OL
-    cerr << "call sentenceOverlap, wordbuffer " << wordbuffer << endl;
-    cerr << "call sentenceOverlap, lemmabuffer " << lemmabuffer << endl;
-#endif
+    fill_overlap_windows( pred, prev_words, prev_lemmas );
+  }
+  NER::Index ner_index;
+  if ( !parseFailCnt ) {
+    ner_index = NER::indexNers( w, s );
   }
   for ( size_t i = 0; i < w.size(); ++i ) {
     xmlNode *alpWord = 0;
     if ( alpDoc ) {
       alpWord = getAlpNodeWord( alpDoc, w[i] );
     }
-    wordStats *ws = new wordStats( i, w[i], alpWord, puncts, parseFailCnt == 1 );
+    wordStats *ws = arena.make<wordStats>( i, w[i], annotations, alpWord, puncts,
+                                           parseFailCnt == 1 );
     if ( parseFailCnt ) {
       sv.push_back( ws );
       continue;
@@ -2274,7 +2783,7 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
     if ( woprProbsV_bwd[i] != -99 )
       ws->logprob10_bwd = woprProbsV_bwd[i];
     if ( pred ) {
-      ws->getSentenceOverlap( wordbuffer, lemmabuffer );
+      ws->getSentenceOverlap( prev_words, prev_lemmas );
     }
 
     if ( ws->lemma[ws->lemma.length() - 1] == '?' ) {
@@ -2299,7 +2808,7 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
       if ( ws->tag == CGN::WW ) verbCnt++;
       if ( ws->tag == CGN::ADJ ) adjCnt++;
 
-      NER::Type ner = NER::lookupNer( w[i], s );
+      NER::Type ner = ner_index[i];
       ws->nerProp = ner;
 
       // If we did not find a SEM::Type for a noun, use the NER::Type to possibly find one.
@@ -2329,7 +2838,9 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
       charCntExNames += ws->charCntExNames;
       morphCnt += ws->morphCnt;
       morphCntExNames += ws->morphCntExNames;
-      aggregate( distances, ws->distances );
+      if ( ws->distances ) {
+        distances.merge( *ws->distances );
+      }
 
       if ( ws->isContent ) {
         word_freq += ws->word_freq_log;
@@ -2813,14 +3324,30 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
   }
   al_gem = getMeanAL();
   al_max = getHighestAL();
-  resolveConnectives();
-  resolveSituations();
+  // find all multi-word expressions in one go
+  vector<string> words( sv.size() );
+  vector<string> lemmas( sv.size() );
+  for ( size_t i = 0; i < sv.size(); ++i ) {
+    words[i] = sv[i]->ltext();
+    lemmas[i] = sv[i]->Lemma();
+  }
+  PhraseMatches word_phrases;
+  PhraseMatches lemma_phrases;
+  settings.word_phrases.match( words, word_phrases );
+  settings.lemma_phrases.match( lemmas, lemma_phrases );
+  resolveConnectives( word_phrases );
+  resolveSituations( lemma_phrases );
+  size_t first = doc_words.size();
+  for ( const auto &word : sv ) {
+    doc_words.push_back( dynamic_cast<const wordStats *>( word ) );
+  }
+  setWordRange( doc_words, first );
   calculate_MTLDs();
-  resolveMultiWordIntensify();
+  resolveMultiWordIntensify( word_phrases );
   // Disabled for now
   //  resolveMultiWordAfks();
-  resolveMultiWordFormal();
-  resolvePrepExpr();
+  resolveMultiWordFormal( word_phrases );
+  resolvePrepExpr( word_phrases );
   if ( question )
     questCnt = 1;
   if ( ( morphNegCnt + propNegCnt ) > 1 )
@@ -2836,7 +3363,7 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
   word_freq_log_n_strict = proportion( word_freq_n_strict, contentStrictCnt - nameCnt ).p;
   lemma_freq_log_n_strict = proportion( lemma_freq_n_strict, contentStrictCnt - nameCnt ).p;
 
-  np_length( s, npCnt, indefNpCnt, npSize );
+  np_length( annotations, npCnt, indefNpCnt, npSize );
   rarityLevel = settings.rarityLevel;
   overlapSize = settings.overlapSize;
 
@@ -2864,65 +3391,38 @@ sentStats::sentStats( const string &inName, int index, folia::Sentence *s, const
   perplexity_bwd_norm = proportion( perplexity_bwd, pow( w.size(), 2 ) ).p;
 }
 
-Conn::Type sentStats::checkMultiConnectives( const string &mword ) {
-  Conn::Type conn = Conn::NOCONN;
-  if ( settings.multi_temporals.find( mword ) != settings.multi_temporals.end() ) {
-    conn = Conn::TEMPOREEL;
-  }
-  else if ( settings.multi_opsommers_wg.find( mword ) != settings.multi_opsommers_wg.end() ) {
-    conn = Conn::OPSOMMEND_WG;
-  }
-  else if ( settings.multi_opsommers_zin.find( mword ) != settings.multi_opsommers_zin.end() ) {
-    conn = Conn::OPSOMMEND_ZIN;
-  }
-  else if ( settings.multi_contrast.find( mword ) != settings.multi_contrast.end() ) {
-    conn = Conn::CONTRASTIEF;
-  }
-  else if ( settings.multi_compars.find( mword ) != settings.multi_compars.end() ) {
-    conn = Conn::COMPARATIEF;
-  }
-  else if ( settings.multi_causals.find( mword ) != settings.multi_causals.end() ) {
-    conn = Conn::CAUSAAL;
-  }
-  //  cerr << "multi-conn " << mword << " = " << conn << endl;
-  return conn;
+Conn::Type sentStats::checkMultiConnectives( const PhraseMatches &phrases,
+                                             size_t start, size_t length ) {
+  int conn = phrases.find( start, length, Phrase::CONNECTIVE );
+  //  cerr << "multi-conn " << start << "," << length << " = " << conn << endl;
+  return conn < 0 ? Conn::NOCONN : static_cast<Conn::Type>( conn );
 }
 
-Situation::Type sentStats::checkMultiSituations( const string &mword ) {
-  //  cerr << "check multi-sit '" << mword << "'" << endl;
-  Situation::Type sit = Situation::NO_SIT;
-  if ( settings.multi_time_sits.find( mword ) != settings.multi_time_sits.end() ) {
-    sit = Situation::TIME_SIT;
-  }
-  else if ( settings.multi_space_sits.find( mword ) != settings.multi_space_sits.end() ) {
-    sit = Situation::SPACE_SIT;
-  }
-  else if ( settings.multi_causal_sits.find( mword ) != settings.multi_causal_sits.end() ) {
-    sit = Situation::CAUSAL_SIT;
-  }
-  else if ( settings.multi_emotion_sits.find( mword ) != settings.multi_emotion_sits.end() ) {
-    sit = Situation::EMO_SIT;
-  }
-  //  cerr << "multi-sit " << mword << " = " << sit << endl;
-  return sit;
+Situation::Type sentStats::checkMultiSituations( const PhraseMatches &phrases,
+                                                 size_t start, size_t length ) {
+  int sit = phrases.find( start, length, Phrase::SITUATION );
+  //  cerr << "multi-sit " << start << "," << length << " = " << sit << endl;
+  return sit < 0 ? Situation::NO_SIT : static_cast<Situation::Type>( sit );
 }
 
-void sentStats::resolveMultiWordIntensify() {
+void sentStats::resolveMultiWordIntensify( const PhraseMatches &phrases ) {
   auto assign = [this]( wordStats *word, Intensify::Type type ) {
     ++intensCombiCnt;
     ++intensCnt;
     word->intensify_type = type;
   };
 
-  resolveMultiWord( sv, settings.intensify, max_length_intensify, assign );
+  resolveMultiWord<Intensify::Type>( sv, phrases, Phrase::INTENSIFY,
+                                     max_length_intensify, assign );
 }
 
-void sentStats::resolveMultiWordFormal() {
+void sentStats::resolveMultiWordFormal( const PhraseMatches &phrases ) {
   auto assign = []( wordStats *word, Formal::Type type ) {
     word->formal_type = type;
   };
 
-  resolveMultiWord( sv, settings.formal, max_length_formal, assign );
+  resolveMultiWord<Formal::Type>( sv, phrases, Phrase::FORMAL,
+                                  max_length_formal, assign );
 
   for ( size_t i = 0; i < sv.size(); ++i ) {
     sentStats::setFormalCounts( dynamic_cast<wordStats *>( sv[i] ) );
@@ -2964,31 +3464,13 @@ void sentStats::resolveMultiWordFormal() {
 //   }
 // }
 
-void sentStats::resolvePrepExpr() {
+void sentStats::resolvePrepExpr( const PhraseMatches &phrases ) {
   if ( sv.size() > 2 ) {
     for ( size_t i = 0; i < sv.size() - 1; ++i ) {
-      string word = sv[i]->ltext();
-      string mw2 = word + " " + sv[i + 1]->ltext();
-      if ( settings.vzexpr2.find( mw2 ) != settings.vzexpr2.end() ) {
+      size_t length;
+      if ( phrases.shortest( i, 4, Phrase::PREP_EXPR, length ) >= 0 ) {
         ++prepExprCnt;
-        i += 1;
-        continue;
-      }
-      if ( i < sv.size() - 2 ) {
-        string mw3 = mw2 + " " + sv[i + 2]->ltext();
-        if ( settings.vzexpr3.find( mw3 ) != settings.vzexpr3.end() ) {
-          ++prepExprCnt;
-          i += 2;
-          continue;
-        }
-        if ( i < sv.size() - 3 ) {
-          string mw4 = mw3 + " " + sv[i + 3]->ltext();
-          if ( settings.vzexpr4.find( mw4 ) != settings.vzexpr4.end() ) {
-            ++prepExprCnt;
-            i += 3;
-            continue;
-          }
-        }
+        i += length - 1;
       }
     }
   }
@@ -3011,16 +3493,146 @@ void sentStats::resolveAdverbials( xmlDoc *alpDoc ) {
   }
 }
 
-parStats::parStats( const string &inName, int index, folia::Paragraph *p ) :
+/// @brief a cached sentence analysis, with the arena that holds it
+struct cached_sentence {
+  explicit cached_sentence( size_t words ):
+    arena( sizeof( sentStats ) + ( words + 1 ) * ( sizeof( wordStats ) + 16 ) ),
+    ss( 0 ) {};
+  StatsArena arena;
+  word_index words;
+  sentStats *ss;
+};
+
+/// @brief the analyses of earlier sentences, by sentenceKey()
+/// (see sentenceCacheSize)
+map<string, cached_sentence *> sentence_cache;
+deque<string> sentence_cache_order;
+/// @brief the word_ids generation of the cached analyses
+uint32_t sentence_cache_generation = 0;
+
+/// @brief identifies a sentence by its words and their Frog annotation
+string sentenceKey( folia::Sentence *s ) {
+  string key;
+  vector<folia::Word *> w = s->words();
+  for ( size_t i = 0; i < w.size(); ++i ) {
+    key += TiCC::UnicodeToUTF8( w[i]->text() ) + "\t";
+    vector<folia::PosAnnotation *> posV = w[i]->select<folia::PosAnnotation>( frog_pos_set );
+    if ( posV.size() == 1 ) {
+      key += posV[0]->cls();
+    }
+    key += "\t" + w[i]->lemma( frog_lemma_set ) + "\n";
+  }
+  return key;
+}
+
+/// @brief copy a sentence analysis onto another sentence with the same
+/// words
+/// @param orig the analysis to copy
+/// @param index the position of the sentence in its paragraph
+/// @param s the sentence
+/// @param arena where to put the copy
+/// @param doc_words the word index to add the copied words to
+/// @return a new analysis, with its own word analyses
+sentStats *copySentence( const sentStats *orig, int index, folia::Sentence *s,
+                         StatsArena &arena, word_index &doc_words ) {
+  sentStats *ss = arena.make<sentStats>( *orig );
+  ss->folia_node = s;
+  ss->id = s->id();
+  ss->index = index;
+  vector<folia::Word *> w = s->words();
+  size_t first = doc_words.size();
+  for ( size_t i = 0; i < ss->sv.size(); ++i ) {
+    wordStats *ws = arena.make<wordStats>( *dynamic_cast<const wordStats *>( orig->sv[i] ) );
+    ws->folia_node = w[i];
+    ws->id = w[i]->id();
+    ss->sv[i] = ws;
+    doc_words.push_back( ws );
+  }
+  ss->setWordRange( doc_words, first );
+  return ss;
+}
+
+/// @brief compute the overlap with the previous sentence again, the only
+/// part of a sentence analysis that depends on its context
+void redoSentenceOverlap( sentStats *ss, const sentStats *pred ) {
+  ss->wordOverlapCnt = 0;
+  ss->lemmaOverlapCnt = 0;
+  if ( ss->parseFailCnt ) {
+    return;
+  }
+  OverlapWindow prev_words;
+  OverlapWindow prev_lemmas;
+  if ( pred ) {
+    fill_overlap_windows( pred, prev_words, prev_lemmas );
+  }
+  for ( size_t i = 0; i < ss->sv.size(); ++i ) {
+    wordStats *ws = dynamic_cast<wordStats *>( ss->sv[i] );
+    ws->wordOverlapCnt = 0;
+    ws->lemmaOverlapCnt = 0;
+    if ( pred ) {
+      ws->getSentenceOverlap( prev_words, prev_lemmas );
+    }
+    if ( ws->prop != CGN::ISLET ) {
+      ss->wordOverlapCnt += ws->wordOverlapCnt;
+      ss->lemmaOverlapCnt += ws->lemmaOverlapCnt;
+    }
+  }
+}
+
+/// @brief analyse a sentence, or reuse the analysis of an identical
+/// sentence seen earlier in this run
+sentStats *analyseSentence( const string &inName, int index, folia::Sentence *s,
+                            const sentStats *pred, StatsArena &arena,
+                            word_index &doc_words ) {
+  if ( settings.sentenceCacheSize == 0 ) {
+    return arena.make<sentStats>( inName, index, s, pred, arena, doc_words );
+  }
+  if ( sentence_cache_generation != word_ids.generation() ) {
+    // the interned ids of the cached analyses are no longer valid
+    for ( const auto &it : sentence_cache ) {
+      delete it.second;
+    }
+    sentence_cache.clear();
+    sentence_cache_order.clear();
+    sentence_cache_generation = word_ids.generation();
+  }
+  string key = sentenceKey( s );
+  auto it = sentence_cache.find( key );
+  if ( it != sentence_cache.end() ) {
+    cerr << "reuse analysis of sentence=" << it->second->ss->text << endl;
+    sentStats *ss = copySentence( it->second->ss, index, s, arena, doc_words );
+    redoSentenceOverlap( ss, pred );
+    return ss;
+  }
+  sentStats *ss = arena.make<sentStats>( inName, index, s, pred, arena, doc_words );
+  if ( sentence_cache.size() >= settings.sentenceCacheSize ) {
+    // forget the oldest
+    auto old = sentence_cache.find( sentence_cache_order.front() );
+    delete old->second;
+    sentence_cache.erase( old );
+    sentence_cache_order.pop_front();
+  }
+  cached_sentence *cs = new cached_sentence( ss->sv.size() );
+  cs->ss = copySentence( ss, index, s, cs->arena, cs->words );
+  sentence_cache[key] = cs;
+  sentence_cache_order.push_back( key );
+  return ss;
+}
+
+parStats::parStats( const string &inName, int index, folia::Paragraph *p,
+                    StatsArena &arena, word_index &doc_words ) :
     structStats( index, p, "par" ) {
   sentCnt = 0;
+  size_t first = doc_words.size();
   vector<folia::Sentence *> sents = p->sentences();
   sentStats *prev = 0;
   for ( size_t i = 0; i < sents.size(); ++i ) {
-    sentStats *ss = new sentStats( inName + "." + to_string( index + 1 ), i, sents[i], prev );
+    sentStats *ss = analyseSentence( inName + "." + to_string( index + 1 ), i, sents[i], prev,
+                                     arena, doc_words );
     prev = ss;
     merge( ss );
   }
+  setWordRange( doc_words, first );
   calculate_MTLDs();
 
   word_freq_log = proportion( word_freq, contentCnt ).p;
@@ -3036,62 +3648,50 @@ parStats::parStats( const string &inName, int index, folia::Paragraph *p ) :
 
 // #define DEBUG_DOL
 
-void docStats::calculate_doc_overlap() {
-  vector<const wordStats *> wv2 = collectWords();
-  if ( wv2.size() < settings.overlapSize )
-    return;
-  vector<string> wordbuffer;
-  vector<string> lemmabuffer;
-  for ( vector<const wordStats *>::const_iterator it = wv2.begin();
-        it != wv2.end();
-        ++it ) {
+/// @brief count the document overlap of the next words of the document
+/// @param wv2 the words
+/// @param words the last overlapSize words before them
+/// @param lemmas the last overlapSize lemmas before them
+void docStats::add_doc_overlap( const word_range &wv2,
+                                OverlapWindow &words,
+                                OverlapWindow &lemmas ) {
+  for ( auto it = wv2.begin(); it != wv2.end(); ++it ) {
     if ( ( *it )->wordProperty() == CGN::ISLET )
       continue;
-    string l_word = ( *it )->ltext();
-    string l_lemma = ( *it )->llemma();
-    if ( wordbuffer.size() >= settings.overlapSize ) {
+    if ( words.full() ) {
 #ifdef DEBUG_DOL
-      cerr << "Document overlap" << endl;
-      cerr << "wordbuffer= " << wordbuffer << endl;
-      cerr << "lemmabuffer= " << lemmabuffer << endl;
-      cerr << "test overlap: << " << l_word << " " << l_lemma << endl;
+      cerr << "Document overlap, test: " << ( *it )->ltext() << " "
+           << ( *it )->llemma() << endl;
 #endif
       if ( ( *it )->isOverlapCandidate() ) {
+        if ( words.overlaps( ( *it )->l_word.id() ) ) {
+          ++doc_word_overlapCnt;
 #ifdef DEBUG_DOL
-        int tmp = doc_word_overlapCnt;
+          cerr << "word OVERLAP " << ( *it )->ltext() << endl;
 #endif
-        argument_overlap( l_word, wordbuffer, doc_word_overlapCnt );
-#ifdef DEBUG_DOL
-        if ( doc_word_overlapCnt > tmp ) {
-          cerr << "word OVERLAP " << l_word << endl;
         }
-#endif
+        if ( lemmas.overlaps( ( *it )->l_lemma.id() ) ) {
+          ++doc_lemma_overlapCnt;
 #ifdef DEBUG_DOL
-        tmp = doc_lemma_overlapCnt;
+          cerr << "lemma OVERLAP " << ( *it )->llemma() << endl;
 #endif
-        argument_overlap( l_lemma, lemmabuffer, doc_lemma_overlapCnt );
-#ifdef DEBUG_DOL
-        if ( doc_lemma_overlapCnt > tmp ) {
-          cerr << "lemma OVERLAP " << l_lemma << endl;
         }
-#endif
       }
 #ifdef DEBUG_DOL
       else {
         cerr << "geen kandidaat" << endl;
       }
 #endif
-      wordbuffer.erase( wordbuffer.begin() );
-      lemmabuffer.erase( lemmabuffer.begin() );
     }
-    wordbuffer.push_back( l_word );
-    lemmabuffer.push_back( l_lemma );
+    words.push( ( *it )->l_word.id() );
+    lemmas.push( ( *it )->l_lemma.id() );
   }
 }
 
-docStats::docStats( const string &inName, folia::Document *doc ) :
+docStats::docStats( const string &inName, folia::Document *doc,
+                    StatsArena &arena ) :
     structStats( 0, 0, "document" ),
-    doc_word_overlapCnt( 0 ), doc_lemma_overlapCnt( 0 ) {
+    doc_word_overlapCnt( 0 ), doc_lemma_overlapCnt( 0 ), parCnt( 0 ) {
   sentCnt = 0;
   doc->declare( folia::AnnotationType::METRIC,
                 "metricset",
@@ -3102,14 +3702,86 @@ docStats::docStats( const string &inName, folia::Document *doc ) :
   if ( !settings.style.empty() ) {
     doc->replaceStyle( "text/xsl", settings.style );
   }
+  const bool prefetch = settings.doAlpinoServer || settings.doWopr;
+  if ( prefetch ) {
+    forgetPrefetched(); // left by a document that failed
+  }
   vector<folia::Paragraph *> pars = doc->paragraphs();
   if ( pars.size() > 0 )
     folia_node = pars[0]->parent();
-  for ( size_t i = 0; i != pars.size(); ++i ) {
-    parStats *ps = new parStats( inName, i, pars[i] );
-    merge( ps );
+  // the document level MTLD and overlap only need the word ids, which
+  // are collected paragraph by paragraph
+  vector<mtld_series> series( MTLD_SERIES_COUNT );
+  OverlapWindow overlap_words( settings.overlapSize );
+  OverlapWindow overlap_lemmas( settings.overlapSize );
+  if ( settings.boundedMemory ) {
+    // each paragraph is written and freed as soon as it is done, so only
+    // the document level data remain
+    unique_ptr<paragraphWriter> writer;
+    vector<csvKind> kinds;
+    for ( const csvKind what : { PAR_CSV, SENT_CSV, WORD_CSV } ) {
+      if ( settings.doCSV( what ) ) {
+        kinds.push_back( what );
+      }
+    }
+    if ( !kinds.empty() && settings.columnarOutput ) {
+      writer.reset( new paragraphWriter( inName, kinds, columnar_corpus ) );
+    }
+    else if ( !kinds.empty() ) {
+      writer.reset( new paragraphWriter( inName, kinds, corpus_csv ) );
+    }
+    // the backend requests run one paragraph ahead of the analysis, so
+    // no more than two paragraphs are waiting for replies
+    if ( prefetch && !pars.empty() ) {
+      prefetchBackends( pars[0]->sentences() );
+    }
+    word_index par_words;
+    for ( size_t i = 0; i != pars.size(); ++i ) {
+      if ( prefetch && i + 1 < pars.size() ) {
+        prefetchBackends( pars[i + 1]->sentences() );
+      }
+      splitCompounds( pars[i]->words() );
+      StatsArena par_arena;
+      parStats *ps = par_arena.make<parStats>( inName, i, pars[i], par_arena, par_words );
+      merge( ps );
+      ++parCnt;
+      add_mtld_series( ps->words(), series );
+      add_doc_overlap( ps->words(), overlap_words, overlap_lemmas );
+      if ( settings.doFolia ) {
+        ps->addMetrics();
+      }
+      if ( writer ) {
+        writer->add( ps );
+      }
+      sv.pop_back();
+      par_words.clear();
+    }
+    if ( writer ) {
+      // only a complete document goes to the corpus output
+      writer->commit();
+    }
   }
-  calculate_MTLDs();
+  else {
+    if ( prefetch ) {
+      prefetchBackends( doc->sentences() );
+    }
+    vector<folia::Word *> all = doc->words();
+    splitCompounds( all );
+    // one word index for the whole document, without reallocations
+    doc_words.reserve( all.size() );
+    series[WORDS].reserve( all.size() );
+    series[LEMMAS].reserve( all.size() );
+    for ( size_t i = 0; i != pars.size(); ++i ) {
+      parStats *ps = arena.make<parStats>( inName, i, pars[i], arena, doc_words );
+      merge( ps );
+      ++parCnt;
+      add_mtld_series( ps->words(), series );
+      add_doc_overlap( ps->words(), overlap_words, overlap_lemmas );
+    }
+    setWordRange( doc_words, 0 );
+  }
+  forgetPrefetched();
+  calculate_MTLDs( series );
 
   word_freq_log = proportion( word_freq, contentCnt ).p;
   lemma_freq_log = proportion( lemma_freq, contentCnt ).p;
@@ -3121,8 +3793,6 @@ docStats::docStats( const string &inName, folia::Document *doc ) :
   word_freq_log_n_strict = proportion( word_freq_n_strict, contentStrictCnt - nameCnt ).p;
   lemma_freq_log_n_strict = proportion( lemma_freq_n_strict, contentStrictCnt - nameCnt ).p;
 
-  calculate_doc_overlap();
-
   rarity_index = rarity( settings.rarityLevel );
 }
 
@@ -3268,24 +3938,29 @@ void AlpinoLookupAdd( folia::Sentence *sent, const string &filename ) {
 
 // #define DEBUG_ALPINO
 
-xmlDoc *AlpinoServerParse( folia::Sentence *sent ) {
+shared_future<string> requestAlpino( const folia::Sentence *sent ) {
   string host = config.lookUp( "host", "alpino" );
   string port = config.lookUp( "port", "alpino" );
-  Sockets::ClientSocket client;
-  if ( !client.connect( host, port ) ) {
-    cerr << "failed to open Alpino connection: " << host << ":" << port << endl;
-    cerr << "Reason: " << client.getMessage() << endl;
-    exit( EXIT_FAILURE );
-  }
-#ifdef DEBUG_ALPINO
-  cerr << "start input loop" << endl;
-#endif
   string txt = TiCC::UnicodeToUTF8( sent->toktext() );
-  client.write( txt + "\n\n" );
+  return backendClient().request( host, port, txt + "\n\n" );
+}
+
+/// @brief Parse a sentence using the Alpino server
+/// @param sent the sentence
+/// @param reply the reply to an earlier request, if it was prefetched
+/// @return the Alpino XML
+xmlDoc *AlpinoServerParse( folia::Sentence *sent, shared_future<string> reply ) {
+  if ( !reply.valid() ) {
+    reply = requestAlpino( sent );
+  }
   string result;
-  string s;
-  while ( client.read( s ) ) {
-    result += s + "\n";
+  string message;
+  if ( !getReply( reply, result, message ) ) {
+    cerr << "failed to open Alpino connection: "
+         << config.lookUp( "host", "alpino" ) << ":"
+         << config.lookUp( "port", "alpino" ) << endl;
+    cerr << "Reason: " << message << endl;
+    exit( EXIT_FAILURE );
   }
 #ifdef DEBUG_ALPINO
   cerr << "received data [" << result << "]" << endl;
@@ -3297,6 +3972,26 @@ xmlDoc *AlpinoServerParse( folia::Sentence *sent ) {
   return doc;
 }
 
+/**
+ * A document travelling through the processing pipeline in main().
+ * Its analysis lives in the arena, and is released with the job.
+ * The lease keeps the interned ids of the analysis valid until then.
+ */
+struct tscan_job {
+  tscan_job( const string& in, const string& out ):
+    inName( in ), outName( out ), doc( 0 ), analyse( 0 ) {};
+  ~tscan_job() {
+    delete doc;
+  };
+  string inName;
+  string outName;
+  string text;
+  folia::Document *doc;
+  unique_ptr<StringInterner::Lease> strings;
+  StatsArena arena;
+  docStats *analyse;
+};
+
 int main( int argc, char *argv[] ) {
   struct stat sbuf;
   pid_t pid = getpid();
@@ -3313,7 +4008,7 @@ int main( int argc, char *argv[] ) {
   cerr << "TScan " << VERSION << endl;
   cerr << "working dir " << workdir_name << endl;
   string shortOpt = "ht:o:VnS";
-  string longOpt = "threads:,config:,skip:,version,stdin";
+  string longOpt = "threads:,config:,skip:,version,stdin,frogworkers:,outputworkers:,queuesize:,memreport,bounded,outputs:,corpus:,shardsize:,columnar";
   TiCC::CL_Options opts( shortOpt, longOpt );
   try {
     opts.init( argc, argv );
@@ -3374,6 +4069,25 @@ int main( int argc, char *argv[] ) {
 #endif
   }
 
+  size_t frog_workers = 1;
+  size_t output_workers = 1;
+  size_t queue_size = 2;
+  if ( opts.extract( "frogworkers", val ) ) {
+    frog_workers = TiCC::stringTo<size_t>( val );
+  }
+  if ( opts.extract( "outputworkers", val ) ) {
+    output_workers = TiCC::stringTo<size_t>( val );
+  }
+  if ( opts.extract( "queuesize", val ) ) {
+    queue_size = TiCC::stringTo<size_t>( val );
+  }
+  const bool mem_report = opts.extract( "memreport" );
+  if ( frog_workers < 1 || output_workers < 1 || queue_size < 1 ) {
+    cerr << "wrong value for 'frogworkers', 'outputworkers' or 'queuesize' option. (must be >= 1)"
+         << endl;
+    exit( EXIT_FAILURE );
+  }
+
   opts.extract( "config", configFile );
   if ( !configFile.empty() && config.fill( configFile ) ) {
     settings.init( config );
@@ -3382,6 +4096,16 @@ int main( int argc, char *argv[] ) {
     cerr << "invalid configuration" << endl;
     exit( EXIT_FAILURE );
   }
+  val = config.lookUp( "memoCacheDir" );
+  if ( !val.empty() ) {
+    compound_memo.open( val, config.lookUp( "method", "compound_splitter" )
+                        + "-" + config.lookUp( "version", "compound_splitter" ) );
+    lemma_memo.open( val, "frog-" + config.lookUp( "version", "frog" ) );
+    if ( settings.doWopr ) {
+      wopr_fwd_memo.open( val, woprModel( "fwd" ) );
+      wopr_bwd_memo.open( val, woprModel( "bwd" ) );
+    }
+  }
   if ( settings.showProblems ) {
     problemFile.open( "problems.log" );
     problemFile << "missing,word,lemma,voll_lemma" << endl;
@@ -3389,6 +4113,9 @@ int main( int argc, char *argv[] ) {
   if ( opts.extract( 'n' ) ) {
     settings.sentencePerLine = true;
   }
+  if ( opts.extract( "bounded" ) ) {
+    settings.boundedMemory = true;
+  }
   if ( opts.extract( "skip", val ) ) {
     string skip = val;
     if ( skip.find_first_of( "wW" ) != string::npos ) {
@@ -3402,6 +4129,64 @@ int main( int argc, char *argv[] ) {
       settings.doXfiles = false;
     }
   };
+  if ( opts.extract( "outputs", val ) ) {
+    settings.doFolia = false;
+    fill( settings.csvOutputs, settings.csvOutputs + WORD_CSV + 1, false );
+    vector<string> outputs;
+    TiCC::split_at( val, outputs, "," );
+    for ( const auto &output : outputs ) {
+      if ( output == "folia" ) {
+        settings.doFolia = true;
+      }
+      else if ( output == "doc" ) {
+        settings.csvOutputs[DOC_CSV] = true;
+      }
+      else if ( output == "par" ) {
+        settings.csvOutputs[PAR_CSV] = true;
+      }
+      else if ( output == "sent" ) {
+        settings.csvOutputs[SENT_CSV] = true;
+      }
+      else if ( output == "word" ) {
+        settings.csvOutputs[WORD_CSV] = true;
+      }
+      else {
+        cerr << "unknown output '" << output << "' in --outputs option" << endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+  }
+  string corpus_prefix;
+  size_t shard_size = 0;
+  if ( opts.extract( "corpus", corpus_prefix ) ) {
+    settings.corpusOutput = true;
+  }
+  if ( opts.extract( "shardsize", val ) ) {
+    if ( !settings.corpusOutput ) {
+      cerr << "the 'shardsize' option needs the 'corpus' option" << endl;
+      exit( EXIT_FAILURE );
+    }
+    // in MB, or in KB or bytes with a K or B suffix
+    size_t unit = 1024 * 1024;
+    const char suffix = val.empty() ? 0 : toupper( static_cast<unsigned char>( val.back() ) );
+    if ( suffix == 'M' || suffix == 'K' || suffix == 'B' ) {
+      unit = ( suffix == 'M' ) ? 1024 * 1024 : ( suffix == 'K' ) ? 1024 : 1;
+      val.pop_back();
+    }
+    size_t size = 0;
+    if ( !TiCC::stringTo( val, size ) || size == 0 ) {
+      cerr << "invalid value for the 'shardsize' option" << endl;
+      exit( EXIT_FAILURE );
+    }
+    shard_size = size * unit;
+  }
+  if ( opts.extract( "columnar" ) ) {
+    settings.columnarOutput = true;
+    if ( shard_size > 0 ) {
+      cerr << "the 'shardsize' option is not supported for columnar output" << endl;
+      exit( EXIT_FAILURE );
+    }
+  }
   if ( !opts.empty() ) {
     cerr << "unsupported options in command: " << opts.toString() << endl;
     exit( EXIT_FAILURE );
@@ -3414,6 +4199,136 @@ int main( int argc, char *argv[] ) {
   if ( fromStdin ) {
       cout << "$ WAITING ON STDIN. USE . TO EXIT " << endl;
   }
+
+  // The documents flow through a pipeline of stages, connected by bounded
+  // queues: reading (this thread) -> Frog -> analysis -> output.
+  // So document N+1 can be frogged while document N is analysed and
+  // document N-1 is written.
+  // The analysis stage uses a single worker: it shares the Alpino lookup
+  // table, the working dir and the problems log, and is parallelized
+  // internally already.
+  BoundedQueue<tscan_job*> read_queue( queue_size );
+  BoundedQueue<tscan_job*> frog_queue( queue_size );
+  BoundedQueue<tscan_job*> analyse_queue( queue_size );
+  mutex out_lock;
+  bool failed = false;
+  const bool single_file = !o_option.empty();
+  const vector<string> tables = { "document", "paragraphs", "sentences", "words" };
+  unique_ptr<CorpusWriter> corpus;
+  vector<unique_ptr<ColumnarWriter>> columnar_files( tables.size() );
+  if ( settings.corpusOutput && settings.doXfiles ) {
+    if ( settings.columnarOutput ) {
+      for ( const csvKind what : { DOC_CSV, PAR_CSV, SENT_CSV, WORD_CSV } ) {
+        if ( settings.doCSV( what ) ) {
+          string fname = corpus_prefix + "." + tables[what] + ".tscol";
+          columnar_files[what].reset( new ColumnarWriter( fname ) );
+          columnar_corpus[what] = columnar_files[what].get();
+          if ( !columnar_files[what]->good() ) {
+            cerr << "unable to open " << fname << endl;
+            exit( EXIT_FAILURE );
+          }
+        }
+      }
+    }
+    else {
+      corpus.reset( new CorpusWriter( corpus_prefix, tables, shard_size ) );
+      corpus_csv = corpus.get();
+    }
+  }
+  vector<thread> workers;
+  startStage( workers, frog_workers, read_queue, frog_queue,
+              [&]( tscan_job *job, tscan_job *&result ) -> bool {
+                istringstream is( job->text );
+                job->text.clear();
+                job->doc = getFrogResult( is );
+                if ( !job->doc ) {
+                  cerr << "big trouble: no FoLiA document created " << endl;
+                  lock_guard<mutex> lock( out_lock );
+                  failed = true;
+                  delete job;
+                  return false;
+                }
+                result = job;
+                return true;
+              } );
+  startStage( workers, 1, frog_queue, analyse_queue,
+              [&]( tscan_job *job, tscan_job *&result ) -> bool {
+                job->strings.reset( new StringInterner::Lease( word_ids ) );
+                job->analyse = job->arena.make<docStats>( job->inName, job->doc,
+                                                          job->arena );
+                if ( mem_report ) {
+                  lock_guard<mutex> lock( out_lock );
+                  job->analyse->memoryReport( cerr, job->inName, job->arena );
+                }
+                result = job;
+                return true;
+              } );
+  startSink( workers, output_workers, analyse_queue,
+             [&]( tscan_job *job ) {
+               if ( settings.doFolia ) {
+                 job->analyse->addMetrics(); // add metrics info to doc
+                 job->doc->save( job->outName );
+               }
+               if ( corpus ) {
+                 vector<string> texts( WORD_CSV + 1 );
+                 for ( const csvKind what : { DOC_CSV, PAR_CSV, SENT_CSV, WORD_CSV } ) {
+                   if ( settings.doCSV( what )
+                        && ( what == DOC_CSV || !settings.boundedMemory ) ) {
+                     // in bounded memory mode the rest was added at the
+                     // end of the analysis
+                     texts[what] = job->analyse->csvText( job->inName, what );
+                   }
+                 }
+                 corpus->add( texts );
+               }
+               else if ( settings.columnarOutput ) {
+                 for ( const csvKind what : { DOC_CSV, PAR_CSV, SENT_CSV, WORD_CSV } ) {
+                   if ( !settings.doCSV( what )
+                        || ( what != DOC_CSV && settings.boundedMemory ) ) {
+                     // in bounded memory mode written at the end of the analysis
+                     continue;
+                   }
+                   if ( settings.corpusOutput ) {
+                     job->analyse->toColumns( *columnar_corpus[what],
+                                              job->inName, what );
+                   }
+                   else {
+                     string fname = job->inName + "." + tables[what] + ".tscol";
+                     ColumnarWriter columnar( fname );
+                     if ( columnar.good() ) {
+                       job->analyse->toColumns( columnar, job->inName, what );
+                       cerr << "stored " << tables[what] << " statistics in " << fname << endl;
+                     }
+                     else {
+                       cerr << "storing " << tables[what] << " statistics in " << fname << " FAILED!" << endl;
+                     }
+                   }
+                 }
+               }
+               else {
+                 if ( settings.doCSV( DOC_CSV ) ) {
+                   job->analyse->toCSV( job->inName, DOC_CSV );
+                 }
+                 if ( !settings.boundedMemory ) {
+                   // else written during the analysis already
+                   for ( const csvKind what : { PAR_CSV, SENT_CSV, WORD_CSV } ) {
+                     if ( settings.doCSV( what ) ) {
+                       job->analyse->toCSV( job->inName, what );
+                     }
+                   }
+                 }
+               }
+               lock_guard<mutex> lock( out_lock );
+               if ( settings.doFolia ) {
+                 cerr << "saved output in " << job->outName << endl;
+               }
+               if ( fromStdin ) {
+                 // show that the file has been processed
+                 cout << job->inName << endl;
+               }
+               delete job;
+             } );
+  read_queue.addProducers( 1 );
   size_t i = 0;
   while ( true ) {
     string inName;
@@ -3443,7 +4358,7 @@ int main( int argc, char *argv[] ) {
     }
 
     string outName;
-    if ( !o_option.empty() ) {
+    if ( single_file ) {
       // just 1 inputfile
       outName = o_option;
     }
@@ -3453,42 +4368,38 @@ int main( int argc, char *argv[] ) {
     ifstream is( inName.c_str() );
     if ( !is ) {
       cerr << "failed to open file '" << inName << "'" << endl;
-      if ( !o_option.empty() ) {
+      if ( single_file ) {
         // just 1 inputfile
-        exit( EXIT_FAILURE );
+        lock_guard<mutex> lock( out_lock );
+        failed = true;
       }
       continue;
     }
-    else {
-      cerr << "opened file " << inName << endl;
-      folia::Document *doc = getFrogResult( is );
-      if ( !doc ) {
-        cerr << "big trouble: no FoLiA document created " << endl;
-        if ( !o_option.empty() ) {
-          // just 1 inputfile
-          exit( EXIT_FAILURE );
-        }
-        continue;
-      }
-      else {
-        docStats analyse( inName, doc );
-        analyse.addMetrics(); // add metrics info to doc
-        doc->save( outName );
-        if ( settings.doXfiles ) {
-          analyse.toCSV( inName, DOC_CSV );
-          analyse.toCSV( inName, PAR_CSV );
-          analyse.toCSV( inName, SENT_CSV );
-          analyse.toCSV( inName, WORD_CSV );
-        }
-        delete doc;
-        cerr << "saved output in " << outName << endl;
-      }
-    }
-
-    if ( fromStdin ) {
-      // show that the file has been processed
-      cout << inName << endl;
-    }
+    cerr << "opened file " << inName << endl;
+    tscan_job *job = new tscan_job( inName, outName );
+    ostringstream content;
+    content << is.rdbuf();
+    job->text = content.str();
+    read_queue.push( job );
+  }
+  read_queue.producerDone();
+  for ( auto& worker : workers ) {
+    worker.join();
+  }
+  corpus_csv = 0;
+  corpus.reset(); // close the corpus output
+  fill( columnar_corpus, columnar_corpus + WORD_CSV + 1, nullptr );
+  columnar_files.clear();
+  if ( single_file && failed ) {
+    exit( EXIT_FAILURE );
+  }
+  if ( config.lookUp( "useCompoundSplitter" ) == "1" ) {
+    compound_memo.report( cerr );
+    lemma_memo.report( cerr );
+  }
+  if ( settings.doWopr ) {
+    wopr_fwd_memo.report( cerr );
+    wopr_bwd_memo.report( cerr );
   }
   if ( settings.saveAlpinoOutput ) {
     saveAlpinoLookup( settings.alpinoLookup, "out" );
@@ -1,13 +1,8 @@
 #include "tscan/stats.h"
+#include "tscan/overlap.h"
 
 using namespace std;
 
-vector<const wordStats*> wordStats::collectWords() const {
-  vector<const wordStats*> result;
-  result.push_back( this );
-  return result;
-}
-
 bool wordStats::setPersRef() {
   return ( sem_type == SEM::CONCRETE_HUMAN_NOUN ||
        nerProp == NER::PER_B ||
@@ -141,16 +136,16 @@ bool wordStats::checkNominal( const xmlNode *alpWord ) const {
  * CGNProps
  **********/
 
-void wordStats::setCGNProps( const folia::PosAnnotation* pa ) {
+void wordStats::setCGNProps( const posFeatures& feats ) {
   if ( tag == CGN::LET )
     prop = CGN::ISLET;
-  else if ( tag == CGN::SPEC && pos.find("eigen") != string::npos )
+  else if ( tag == CGN::SPEC && pos.str().find("eigen") != string::npos )
     prop = CGN::ISNAME;
   else if ( tag == CGN::WW ){
-    string wvorm = pa->feat("wvorm");
+    const string& wvorm = feats[WVORM];
     if ( wvorm == "inf" ){
       prop = CGN::ISINF;
-      string pos = pa->feat("positie");
+      const string& pos = feats[POSITIE];
       if ( pos == "vrij" ){
 	position = CGN::VRIJ;
       }
@@ -163,7 +158,7 @@ void wordStats::setCGNProps( const folia::PosAnnotation* pa ) {
     }
     else if ( wvorm == "vd" ){
       prop = CGN::ISVD;
-      string pos = pa->feat("positie");
+      const string& pos = feats[POSITIE];
       if ( pos == "vrij" ){
 	position = CGN::VRIJ;
       }
@@ -176,7 +171,7 @@ void wordStats::setCGNProps( const folia::PosAnnotation* pa ) {
     }
     else if ( wvorm == "od" ){
       prop = CGN::ISOD;
-      string pos = pa->feat("positie");
+      const string& pos = feats[POSITIE];
       if ( pos == "vrij" ){
 	position = CGN::VRIJ;
       }
@@ -188,7 +183,7 @@ void wordStats::setCGNProps( const folia::PosAnnotation* pa ) {
       }
     }
     else if ( wvorm == "pv" ){
-      string tijd = pa->feat("pvtijd");
+      const string& tijd = feats[PVTIJD];
       if ( tijd == "tgw" )
 	prop = CGN::ISPVTGW;
       else if ( tijd == "verl" )
@@ -207,16 +202,16 @@ void wordStats::setCGNProps( const folia::PosAnnotation* pa ) {
     }
   }
   else if ( tag == CGN::VNW ){
-    string vwtype = pa->feat("vwtype");
+    const string& vwtype = feats[VWTYPE];
     isBetr = vwtype == "betr";
     if ( l_word != "men"
 	 && l_word != "er"
 	 && l_word != "het" ){
-      string cas = pa->feat("naamval");
+      const string& cas = feats[NAAMVAL];
       archaic = ( cas == "gen" || cas == "dat" );
       if ( vwtype == "pers" || vwtype == "refl"
 	   || vwtype == "pr" || vwtype == "bez" ) {
-	string persoon = pa->feat("persoon");
+	const string& persoon = feats[PERSOON];
 	if ( !persoon.empty() ){
 	  if ( persoon[0] == '1' )
 	    prop = CGN::ISPPRON1;
@@ -239,11 +234,11 @@ void wordStats::setCGNProps( const folia::PosAnnotation* pa ) {
     }
   }
   else if ( tag == CGN::LID ) {
-    string cas = pa->feat("naamval");
+    const string& cas = feats[NAAMVAL];
     archaic = ( cas == "gen" || cas == "dat" );
   }
   else if ( tag == CGN::VG ) {
-    string cp = pa->feat("conjtype");
+    const string& cp = feats[CONJTYPE];
     isOnder = cp == "onder";
   }
 }
@@ -297,7 +292,7 @@ bool wordStats::checkMorphNeg() const {
   }
   else {
     for ( size_t i=0; i < negminus.size(); ++i ){
-      if ( word.find( negminus[i] ) != string::npos )
+      if ( word.str().find( negminus[i] ) != string::npos )
 	return true;
     }
   }
@@ -330,32 +325,22 @@ bool wordStats::isOverlapCandidate() const {
   }
 }
 
-void wordStats::getSentenceOverlap( const vector<string>& wordbuffer,
-            const vector<string>& lemmabuffer ){
+void wordStats::getSentenceOverlap( const OverlapWindow& prev_words,
+                                    const OverlapWindow& prev_lemmas ){
   if ( isOverlapCandidate() ){
-    // get the words and lemmas' of the previous sentence
+    // overlap with the words and lemmas' of the previous sentence
+    if ( prev_words.overlaps( l_word.id() ) ){
+      ++wordOverlapCnt;
 #ifdef DEBUG_OL
-    cerr << "call word sentenceOverlap, word = " << l_word;
-    int tmp2 = wordOverlapCnt;
+      cerr << "word sentenceOverlap, word = " << l_word << " OVERLAPPED" << endl;
 #endif
-    argument_overlap( l_word, wordbuffer, wordOverlapCnt );
-#ifdef DEBUG_OL
-    if ( tmp2 != wordOverlapCnt ){
-      cerr << " OVERLAPPED " << endl;
     }
-    else
-      cerr << endl;
-    cerr << "call lemma sentenceOverlap, lemma= " << l_lemma;
-    tmp2 = lemmaOverlapCnt;
-#endif
-    argument_overlap( l_lemma, lemmabuffer, lemmaOverlapCnt );
+    if ( prev_lemmas.overlaps( l_lemma.id() ) ){
+      ++lemmaOverlapCnt;
 #ifdef DEBUG_OL
-    if ( tmp2 != lemmaOverlapCnt ){
-      cerr << " OVERLAPPED " << endl;
-    }
-    else
-      cerr << endl;
+      cerr << "lemma sentenceOverlap, lemma= " << l_lemma << " OVERLAPPED" << endl;
 #endif
+    }
   }
 }
 
@@ -368,17 +353,17 @@ void wordStats::getSentenceOverlap( const vector<string>& wordbuffer,
  * @param os  the current outputstream
  * @param cnt the number of times to print "NA,"
  */
-void na( ostream& os, int cnt ){
+void na( csvRow& os, int cnt ){
   for ( int i=0; i < cnt; ++i ){
     os << "NA,";
   }
-  os << endl;
+  os << "\n";
 }
 
 /**
  * Sets all headers of the wordStats .csv-output.
  */
-void wordStats::CSVheader( ostream& os, const string& ) const {
+void wordStats::CSVheader( csvRow& os, const string& ) const {
   wordSortHeader( os );
   wordDifficultiesHeader( os );
   coherenceHeader( os );
@@ -386,14 +371,14 @@ void wordStats::CSVheader( ostream& os, const string& ) const {
   compoundHeader( os );
   persoonlijkheidHeader( os );
   miscHeader( os );
-  os << endl;
+  os << "\n";
 }
 
 /**
  * Sets all .csv-output for wordStats.
  * @param os the current outputstream
  */
-void wordStats::toCSV( ostream& os ) const {
+void wordStats::toCSV( csvRow& os ) const {
   wordSortToCSV( os );
   if ( parseFail )
     return;
@@ -403,14 +388,14 @@ void wordStats::toCSV( ostream& os ) const {
   compoundToCSV( os );
   persoonlijkheidToCSV( os );
   miscToCSV( os );
-  os << endl;
+  os << "\n";
 }
 
-void wordStats::wordSortHeader( ostream& os ) const {
+void wordStats::wordSortHeader( csvRow& os ) const {
   os << "InputFile,Segment,Woord,lemma,Voll_lemma,morfemen,Samenst_delen_Frog,Wrdsoort,Afk,";
 }
 
-void wordStats::wordSortToCSV( ostream& os ) const {
+void wordStats::wordSortToCSV( csvRow& os ) const {
   os << id << ",";
   os << '"' << word << "\",";
   if ( parseFail ){
@@ -427,7 +412,7 @@ void wordStats::wordSortToCSV( ostream& os ) const {
   }
   os << "\",";
 
-  os << (!compstr.empty() ? compstr : "-") << ",";
+  os << (!compstr.empty() ? compstr.str() : "-") << ",";
 
   os << tag << ",";
   if ( afkType == Afk::NO_A ) {
@@ -438,7 +423,7 @@ void wordStats::wordSortToCSV( ostream& os ) const {
   }
 }
 
-void wordStats::wordDifficultiesHeader( ostream& os ) const {
+void wordStats::wordDifficultiesHeader( csvRow& os ) const {
   os << "Let_per_wrd,Wrd_per_let,Let_per_wrd_zn,Wrd_per_let_zn,"
      << "Morf_per_wrd,Wrd_per_morf,Morf_per_wrd_zn,Wrd_per_morf_zn,"
      << "Wrd_prev,Wrd_prev_z,"
@@ -448,7 +433,7 @@ void wordStats::wordDifficultiesHeader( ostream& os ) const {
      << "Freq1000,Freq2000,Freq3000,Freq5000,Freq10000,Freq20000,";
 }
 
-void wordStats::wordDifficultiesToCSV( ostream& os ) const {
+void wordStats::wordDifficultiesToCSV( csvRow& os ) const {
   os << std::showpoint
      << double(charCnt) << ","
      << 1.0/double(charCnt) <<  ",";
@@ -523,11 +508,11 @@ void wordStats::wordDifficultiesToCSV( ostream& os ) const {
   os << (top_freq<=top20000?1:0) << ",";
 }
 
-void wordStats::coherenceHeader( ostream& os ) const {
+void wordStats::coherenceHeader( csvRow& os ) const {
   os << "Conn_type,Conn_combi,Vnw_ref,";
 }
 
-void wordStats::coherenceToCSV( ostream& os ) const {
+void wordStats::coherenceToCSV( csvRow& os ) const {
   if ( connType == Conn::NOCONN )
     os << "0,";
   else
@@ -536,7 +521,7 @@ void wordStats::coherenceToCSV( ostream& os ) const {
      << isPronRef << ",";
 }
 
-void wordStats::concreetHeader( ostream& os ) const {
+void wordStats::concreetHeader( csvRow& os ) const {
   os << "Semtype_nw,";
   os << "Alg_nw,"; // 20150721: Feature added
   os << "Conc_nw_strikt,";
@@ -549,7 +534,7 @@ void wordStats::concreetHeader( ostream& os ) const {
   os << "Semtype_bw,"; // 20150821: Feature added
 }
 
-void wordStats::concreetToCSV( ostream& os ) const {
+void wordStats::concreetToCSV( csvRow& os ) const {
   if ( tag == CGN::N || prop == CGN::ISNAME ) {
     os << sem_type << ",";
   }
@@ -586,7 +571,7 @@ void wordStats::concreetToCSV( ostream& os ) const {
   }
 }
 
-void wordStats::compoundHeader( ostream& os ) const {
+void wordStats::compoundHeader( csvRow& os ) const {
   os << "Samenst,Samenst_delen,";
   os << "Let_per_wrd_hfdwrd,Let_per_wrd_satwrd,";
   os << "Wrd_freq_log_hfdwrd,Wrd_freq_log_satwrd,Wrd_freq_log_(hfd_sat),";
@@ -595,7 +580,7 @@ void wordStats::compoundHeader( ostream& os ) const {
   os << "Samenst_Frog,";
 }
 
-void wordStats::compoundToCSV( ostream& os ) const {
+void wordStats::compoundToCSV( csvRow& os ) const {
   os << (is_compound ? 1 : 0) << ",";
   if (is_compound) {
     os << double(compound_parts) << ",";
@@ -630,13 +615,13 @@ void wordStats::compoundToCSV( ostream& os ) const {
   os << (!compstr.empty() ? 1 : 0) << ",";
 }
 
-void wordStats::persoonlijkheidHeader( ostream& os ) const {
+void wordStats::persoonlijkheidHeader( csvRow& os ) const {
   os << "Pers_ref,Pers_vnw1,Pers_vnw2,Pers_vnw3,Pers_vnw,"
      << "Naam_POS,Naam_NER," // 20141125: Feature Naam_POS moved
      << "Imp_ellips,"; // 20141125: Feature Pers_nw moved (deleted 20150703) and Emo_bvn deleted
 }
 
-void wordStats::persoonlijkheidToCSV( ostream& os ) const {
+void wordStats::persoonlijkheidToCSV( csvRow& os ) const {
   os << isPersRef << ","
      << (prop == CGN::ISPPRON1 ) << ","
      << (prop == CGN::ISPPRON2 ) << ","
@@ -651,11 +636,11 @@ void wordStats::persoonlijkheidToCSV( ostream& os ) const {
 }
 
 
-void wordStats::miscHeader( ostream& os ) const {
+void wordStats::miscHeader( csvRow& os ) const {
   os << "Ww_vorm,Ww_tt,Vol_dw,Onvol_dw,Infin,Archaisch,Log_prob_fwd,Log_prob_bwd,Intens,Formeel,Op_stoplijst,Eigen_classificatie";
 }
 
-void wordStats::miscToCSV( ostream& os ) const {
+void wordStats::miscToCSV( csvRow& os ) const {
   if ( wwform == ::NO_VERB ){
     os << "0,";
   }
@@ -729,9 +714,9 @@ void wordStats::addMetrics( ) const {
   if ( isMultiConn )
     addOneMetric( doc, el, "multi_connective", "true" );
   if ( !std::isnan(prevalenceP) )
-    addOneMetric( doc, el, "prevalenceP", TiCC::toString(prevalenceP) );
+    addOneMetric( doc, el, "prevalenceP", prevalenceP );
   if ( !std::isnan(prevalenceZ) )
-    addOneMetric( doc, el, "prevalenceZ", TiCC::toString(prevalenceZ) );
+    addOneMetric( doc, el, "prevalenceZ", prevalenceZ );
   if ( f50 )
     addOneMetric( doc, el, "f50", "true" );
   if ( f65 )
@@ -752,22 +737,22 @@ void wordStats::addMetrics( ) const {
     addOneMetric( doc, el, "top10000", "true" );
   else if ( top_freq == top20000 )
     addOneMetric( doc, el, "top20000", "true" );
-  addOneMetric( doc, el, "word_freq", TiCC::toString(word_freq) );
+  addOneMetric( doc, el, "word_freq", word_freq );
   if ( !std::isnan(word_freq_log) )
-    addOneMetric( doc, el, "log_word_freq", TiCC::toString(word_freq_log) );
-  addOneMetric( doc, el, "lemma_freq", TiCC::toString(lemma_freq) );
+    addOneMetric( doc, el, "log_word_freq", word_freq_log );
+  addOneMetric( doc, el, "lemma_freq", lemma_freq );
   if ( !std::isnan(lemma_freq_log) )
-    addOneMetric( doc, el, "log_lemma_freq", TiCC::toString(lemma_freq_log) );
+    addOneMetric( doc, el, "log_lemma_freq", lemma_freq_log );
   addOneMetric( doc, el,
-    "word_overlap_count", TiCC::toString( wordOverlapCnt ) );
+    "word_overlap_count", wordOverlapCnt );
   addOneMetric( doc, el,
-    "lemma_overlap_count", TiCC::toString( lemmaOverlapCnt ) );
+    "lemma_overlap_count", lemmaOverlapCnt );
   if ( !std::isnan(logprob10_fwd) )
-    addOneMetric( doc, el, "lprob10_fwd", TiCC::toString(logprob10_fwd) );
+    addOneMetric( doc, el, "lprob10_fwd", logprob10_fwd );
   if ( !std::isnan(logprob10_bwd) )
-    addOneMetric( doc, el, "lprob10_bwd", TiCC::toString(logprob10_bwd) );
+    addOneMetric( doc, el, "lprob10_bwd", logprob10_bwd );
   if ( prop != CGN::JUSTAWORD )
-    addOneMetric( doc, el, "property", TiCC::toString(prop) );
+    addOneMetric( doc, el, "property", prop );
   if ( sem_type != SEM::NO_SEMTYPE )
     addOneMetric( doc, el, "semtype", SEM::toString(sem_type) );
   if ( intensify_type != Intensify::NO_INTENSIFY )
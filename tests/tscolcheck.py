@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""
+Checks a .tscol file of tscan --columnar against the .csv text of the same
+statistics: the same columns and rows, the same strings, and the same
+numbers up to the 6 digits of the .csv, with NA where the .csv has NA.
+
+    tscolcheck.py file.tscol file.csv
+"""
+import csv
+import math
+import struct
+import sys
+
+DOUBLE = 1
+STRING = 2
+NA_INDEX = 0xFFFFFFFF
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def get(self, fmt):
+        values = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += struct.calcsize(fmt)
+        return values if len(values) > 1 else values[0]
+
+    def string(self):
+        size = self.get("<I")
+        text = self.data[self.pos:self.pos + size].decode("utf-8")
+        self.pos += size
+        return text
+
+    def done(self):
+        return self.pos >= len(self.data)
+
+
+def read_tscol(filename):
+    with open(filename, "rb") as f:
+        data = f.read()
+    if data[:8] != b"TSCOL02\n":
+        raise ValueError(filename + ": not a TSCOL02 file")
+    reader = Reader(data[8:])
+    schema = [(reader.string(), reader.get("<B"))
+              for _ in range(reader.get("<I"))]
+    columns = [[] for _ in schema]
+    while not reader.done():
+        rows = reader.get("<Q")
+        for (name, kind), values in zip(schema, columns):
+            if kind == DOUBLE:
+                values.extend(reader.get("<%dd" % rows) if rows > 1
+                              else [reader.get("<d")])
+            elif kind == STRING:
+                entries = [reader.string() for _ in range(reader.get("<I"))]
+                for _ in range(rows):
+                    index = reader.get("<I")
+                    values.append(None if index == NA_INDEX else entries[index])
+            else:
+                raise ValueError("%s: column %s has unknown type %d"
+                                 % (filename, name, kind))
+    return [name for name, _ in schema], columns
+
+
+def read_csv(filename):
+    with open(filename, newline="", encoding="utf-8") as f:
+        lines = list(csv.reader(f))
+    if not lines:
+        return [], []
+    names = lines[0]
+    rows = []
+    for line in lines[1:]:
+        # the rows end in a comma; rows of a word without parse are short
+        line = line[:len(names)]
+        rows.append(line + ["NA"] * (len(names) - len(line)))
+    return names, rows
+
+
+def same(value, text):
+    if value is None:
+        return text == "NA"
+    if isinstance(value, str):
+        return value == text
+    if math.isnan(value):
+        return text == "NA"
+    try:
+        number = float(text)
+    except ValueError:
+        return False
+    return math.isclose(value, number, rel_tol=1e-5, abs_tol=1e-300)
+
+
+def main(tscol, csvfile):
+    names, columns = read_tscol(tscol)
+    csv_names, rows = read_csv(csvfile)
+    errors = 0
+    if names != csv_names:
+        print("%s: the columns differ from %s" % (tscol, csvfile))
+        return 1
+    if names and len(columns[0]) != len(rows):
+        print("%s: %d rows, %s has %d" % (tscol, len(columns[0]), csvfile,
+                                         len(rows)))
+        return 1
+    for c, name in enumerate(names):
+        for r, row in enumerate(rows):
+            if not same(columns[c][r], row[c]):
+                print("%s: row %d column %s is %r, %s has %r"
+                      % (tscol, r + 1, name, columns[c][r], csvfile, row[c]))
+                errors += 1
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(2)
+    sys.exit(main(sys.argv[1], sys.argv[2]))